@@ -0,0 +1,267 @@
+// Cycle benchmarks of the hot paths of the sketch, run on the ATmega328P itself or under the cycle-accurate simulator simavr.
+// The sketch is compiled into this file as is (see Makefile), only setup() and loop() are never called.
+// Each benchmark is run BENCHMARK_RUNS times on fixed inputs, its prepare function is not timed. The highest cycle count of
+// all runs is reported, minus the cost of calling an empty benchmark. Results are printed as `bench <name> <cycles>` lines
+// to the simavr console, see track.py for comparing them against earlier commits.
+
+#include "sketch.cpp" // main.ino, with prototypes added by ../host/prototypes.py
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/avr_mcu_section.h> // from simavr, tells simavr the MCU and which register acts as console
+
+AVR_MCU(F_CPU, "atmega328p");
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+#define BENCHMARK_RUNS 8
+
+extern "C" void USART_TX_vect(void) __attribute__((signal)); // DMX TX ISR of Conceptinetics.cpp
+
+/**
+ * @brief Prints to the simavr console register. simavr prints a line whenever it receives '\r'.
+ */
+class SimulatorConsole : public Print
+{
+public:
+    size_t write(uint8_t value) override
+    {
+        if (value != '\n')
+        {
+            GPIOR0 = value;
+        }
+        return 1;
+    }
+    using Print::write;
+};
+
+struct Benchmark
+{
+    const char *name; // in PROGMEM
+    void (*prepare)();
+    void (*run)();
+};
+
+SimulatorConsole console;
+volatile uint16_t timerOverflows = 0;
+uint16_t benchAmplitudes[AUDIO_BANDS];
+uint16_t benchAverage = 0;
+float benchAmplification = 12.0;
+NumericHistory<uint16_t, 32> benchHistory;
+uint16_t *volatile benchHistoryPointer;
+DMXFixture<> benchFixture(1, 255);
+uint8_t benchValue = 0;
+uint8_t benchProfileGroup = 0;
+
+ISR(TIMER1_OVF_vect)
+{
+    timerOverflows++;
+}
+
+// ================================================================
+//                           BENCHMARKS
+// ================================================================
+const uint16_t BENCH_AMPLITUDES[AUDIO_BANDS] = {880, 620, 310, 95, 260, 540, 1010}; // audio frame with clipping and non-clipping bands
+
+void prepareNothing() {}
+void runNothing() {}
+
+void prepareAmplitudes()
+{
+    memcpy(benchAmplitudes, BENCH_AMPLITUDES, sizeof(benchAmplitudes));
+}
+
+void runGetAverage()
+{
+    benchAverage = getAverage(benchAmplitudes, AUDIO_BANDS, 0);
+}
+
+void runMapAudioAmplitude()
+{
+    benchAverage = mapAudioAmplitudeToLightLevel(benchAmplitudes, 300, benchAmplification);
+}
+
+void prepareBrightness()
+{
+    prepareAmplitudes();
+    mapAudioAmplitudeToLightLevel(benchAmplitudes, 300, benchAmplification);
+    profileRotation.update(0);
+}
+
+void runSetFixtureBrightness()
+{
+    setFixtureBrightness(0, benchAmplitudes, profileRotation.getBandResponse(0));
+}
+
+void prepareHistory()
+{
+    benchHistory.update(benchValue++);
+}
+
+void runHistoryGet()
+{
+    benchHistoryPointer = benchHistory.get();
+}
+
+void runHistoryUpdate()
+{
+    benchHistory.update(benchValue);
+}
+
+void prepareFixtureChanged() // every attribute changes, the worst case of display()
+{
+    benchValue += 17;
+    benchFixture.setRGB(benchValue, benchValue + 1, benchValue + 2);
+    benchFixture.setWhite(benchValue + 3);
+    benchFixture.setStrobe(benchValue + 4);
+    benchFixture.setRGBDimmer(benchValue + 5);
+}
+
+void runFixtureDisplay()
+{
+    benchFixture.display(dmxMaster);
+}
+
+void prepareFixturesChanged()
+{
+    benchValue += 17;
+    for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
+    {
+        FIXTURES.setRGB(fixtureId, benchValue, benchValue + 1, benchValue + 2);
+        FIXTURES.setWhite(fixtureId, benchValue + 3);
+        FIXTURES.setRGBDimmer(fixtureId, benchValue + 5);
+    }
+}
+
+void runFixtureBankDisplay()
+{
+    FIXTURES.display(lightInterpolator.getPendingFrame(), DMX_CHANNEL_AMOUNT + 1);
+}
+
+void prepareProfileGroup() // a different profile group reassigns every profile, the worst case of update()
+{
+    benchProfileGroup = (benchProfileGroup + 1) % 4;
+}
+
+void runProfileRotation()
+{
+    profileRotation.update(benchProfileGroup);
+}
+
+void runButtonRead()
+{
+    benchValue = ButtonGroup<8, 9, 6, 5, 3>::read(); // the buttons of main.ino
+}
+
+void prepareDmxBreak() // a new frame was committed, so the break interpolates all channels
+{
+    prepareFixturesChanged();
+    runFixtureBankDisplay();
+    lightInterpolator.commit();
+    dmxMaster.enable();
+    UCSR0B &= ~_BV(TXCIE0); // the ISR is only ever called by the benchmark
+}
+
+void runDmxIsr()
+{
+    USART_TX_vect();
+}
+
+void prepareDmxSlot()
+{
+    prepareDmxBreak();
+    runDmxIsr(); // break
+    runDmxIsr(); // start code, every call from here on transmits a slot
+}
+
+const char NAME_NOTHING[] PROGMEM = "empty";
+const char NAME_GET_AVERAGE[] PROGMEM = "getAverage";
+const char NAME_MAP_AUDIO[] PROGMEM = "mapAudioAmplitudeToLightLevel";
+const char NAME_BRIGHTNESS[] PROGMEM = "setFixtureBrightness";
+const char NAME_HISTORY_GET[] PROGMEM = "NumericHistory::get";
+const char NAME_HISTORY_UPDATE[] PROGMEM = "NumericHistory::update";
+const char NAME_FIXTURE_DISPLAY[] PROGMEM = "DMXFixture::display";
+const char NAME_BANK_DISPLAY[] PROGMEM = "FixtureBank::display";
+const char NAME_ROTATION[] PROGMEM = "ProfileRotation::update";
+const char NAME_BUTTON_READ[] PROGMEM = "ButtonGroup::read";
+const char NAME_DMX_BREAK[] PROGMEM = "DMX_TX_ISR::break";
+const char NAME_DMX_SLOT[] PROGMEM = "DMX_TX_ISR::slot";
+const Benchmark BENCHMARKS[] = {
+    {NAME_NOTHING, prepareNothing, runNothing},
+    {NAME_GET_AVERAGE, prepareAmplitudes, runGetAverage},
+    {NAME_MAP_AUDIO, prepareAmplitudes, runMapAudioAmplitude},
+    {NAME_BRIGHTNESS, prepareBrightness, runSetFixtureBrightness},
+    {NAME_HISTORY_GET, prepareHistory, runHistoryGet},
+    {NAME_HISTORY_UPDATE, prepareHistory, runHistoryUpdate},
+    {NAME_FIXTURE_DISPLAY, prepareFixtureChanged, runFixtureDisplay},
+    {NAME_BANK_DISPLAY, prepareFixturesChanged, runFixtureBankDisplay},
+    {NAME_ROTATION, prepareProfileGroup, runProfileRotation},
+    {NAME_BUTTON_READ, prepareNothing, runButtonRead},
+    {NAME_DMX_BREAK, prepareDmxBreak, runDmxIsr},
+    {NAME_DMX_SLOT, prepareDmxSlot, runDmxIsr}};
+
+// ================================================================
+//                          MEASUREMENT
+// ================================================================
+
+/**
+ * @brief Runs a function and returns the amount of CPU cycles it took, including the cost of the call itself.
+ * Timer1 counts CPU cycles (no prescaler), its overflows are counted by TIMER1_OVF_vect.
+ */
+uint32_t measureCycles(void (*function)())
+{
+    cli();
+    timerOverflows = 0;
+    TCNT1 = 0;
+    TIFR1 = _BV(TOV1);
+    sei();
+
+    function();
+
+    cli();
+    uint16_t cycles = TCNT1;
+    if ((TIFR1 & _BV(TOV1)) && cycles < 0x8000) // overflowed after the ISR could run
+    {
+        timerOverflows++;
+    }
+    uint32_t total = ((uint32_t)timerOverflows << 16) | cycles;
+    sei();
+    return total;
+}
+
+int main()
+{
+    init();        // Arduino core: timers, ADC
+    TIMSK0 = 0;    // stop the millis() interrupt, it would be counted into whatever benchmark it interrupts
+    TCCR1A = 0;    // Timer1: normal mode, counting CPU cycles
+    TCCR1B = _BV(CS10);
+    TIMSK1 = _BV(TOIE1);
+    sei();
+
+    uint32_t callCycles = 0;
+    for (uint8_t benchmark = 0; benchmark < sizeof(BENCHMARKS) / sizeof(Benchmark); benchmark++)
+    {
+        uint32_t maxCycles = 0;
+        for (uint8_t run = 0; run < BENCHMARK_RUNS; run++)
+        {
+            BENCHMARKS[benchmark].prepare();
+            maxCycles = max(maxCycles, measureCycles(BENCHMARKS[benchmark].run));
+        }
+
+        if (benchmark == 0)
+        {
+            callCycles = maxCycles; // the empty benchmark measures the call overhead, which is subtracted from all others
+            continue;
+        }
+        console.print(F("bench "));
+        console.print((const __FlashStringHelper *)BENCHMARKS[benchmark].name);
+        console.print(' ');
+        console.println(maxCycles - callCycles);
+    }
+
+    // sleeping with interrupts disabled ends the simulation
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu();
+    return 0;
+}
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""
+Tracks benchmark results over commits. Reads `bench <name> <cycles>` lines, as printed by the benchmarks, from stdin.
+
+Usage:
+  track.py record <results.tsv> <commit> <toolchain>  appends the results to the results file, tagged with the commit,
+                                                      preceded by a comment naming the toolchain that built the benchmarks
+  track.py check <results.tsv> <tolerance>            compares the results against the last recorded commit,
+                                                      fails if any benchmark takes more than <tolerance> percent more cycles,
+                                                      or if no commit was recorded yet
+"""
+import sys
+
+
+def readResults(lines):
+    results = {}
+    for line in lines:
+        fields = line.split()
+        if len(fields) == 3 and fields[0] == 'bench':
+            results[fields[1]] = int(fields[2])
+    return results
+
+
+def readLastRecorded(resultsPath):
+    commit = None
+    results = {}
+    with open(resultsPath) as resultsFile:
+        for line in resultsFile:
+            if line.startswith('#') or not line.strip():
+                continue
+            lineCommit, name, cycles = line.split('\t')
+            if lineCommit != commit:  # results of a commit are consecutive, only keep the latest commit
+                commit = lineCommit
+                results = {}
+            results[name] = int(cycles)
+    return commit, results
+
+
+def record(resultsPath, commit, toolchain):
+    results = readResults(sys.stdin)
+    if not results:
+        sys.exit('no benchmark results on stdin')
+    with open(resultsPath, 'a') as resultsFile:
+        resultsFile.write('# %s built with %s\n' % (commit, toolchain))
+        for name, cycles in results.items():
+            resultsFile.write('%s\t%s\t%d\n' % (commit, name, cycles))
+    print('recorded %d benchmarks for %s' % (len(results), commit))
+
+
+def check(resultsPath, tolerance):
+    results = readResults(sys.stdin)
+    if not results:
+        sys.exit('no benchmark results on stdin')
+    baseCommit, baseResults = readLastRecorded(resultsPath)
+    if baseCommit is None:
+        sys.exit('no baseline in %s, run `make record` on a known good commit first' % resultsPath)
+
+    regressions = 0
+    print('%-32s %10s %10s %8s' % ('benchmark', baseCommit or '-', 'now', 'change'))
+    for name, cycles in results.items():
+        if name not in baseResults:
+            print('%-32s %10s %10d %8s' % (name, '-', cycles, 'new'))
+            continue
+        change = 100.0 * (cycles - baseResults[name]) / max(baseResults[name], 1)
+        regressed = change > tolerance
+        regressions += regressed
+        print('%-32s %10d %10d %+7.1f%%%s' % (name, baseResults[name], cycles, change, '  REGRESSION' if regressed else ''))
+
+    if regressions:
+        sys.exit('%d benchmark(s) regressed by more than %s%%' % (regressions, tolerance))
+
+
+def main():
+    if (sys.argv[1:2] != ['record'] or len(sys.argv) != 5) and (sys.argv[1:2] != ['check'] or len(sys.argv) != 4):
+        sys.exit(__doc__)
+    if sys.argv[1] == 'record':
+        record(sys.argv[2], sys.argv[3], sys.argv[4])
+    else:
+        check(sys.argv[2], float(sys.argv[3]))
+
+
+if __name__ == '__main__':
+    main()
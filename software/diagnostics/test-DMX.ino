@@ -4,8 +4,8 @@
 // Running this script will cause the fixture on channel 1 to blink.
 
 const uint8_t maxBrightness = 217; // 85% max brightness to increase LED lifetime
-DMXFixture fixture = DMXFixture(1, maxBrightness);
-DMX_Master dmxMaster(fixture.channelAmount, 2);
+DMXFixture<> fixture(1, maxBrightness);
+DMX_Master dmxMaster(fixture.getChannelAmount(), 2);
 bool state = false;
 
 void setup()
@@ -0,0 +1,198 @@
+// Host implementation of the parts of the Conceptinetics library used by the sketch: DMX_FrameBuffer and DMX_Master.
+// DMX_FrameBuffer behaves exactly like the original, DMX_Master transmits through a host timer instead of the USART.
+
+#include "ConceptineticsHost.h"
+#include "HostSimulation.h"
+
+static DMX_Master *activeMaster = nullptr;
+static uint8_t transmitTimer = 0xFF;
+static void (*dmxFrameHook)(const uint8_t *, uint16_t) = nullptr;
+static uint32_t dmxFrameCount = 0;
+
+void hostOnDmxFrame(void (*hook)(const uint8_t *slots, uint16_t slotAmount))
+{
+    dmxFrameHook = hook;
+}
+
+uint32_t hostGetDmxFrameCount()
+{
+    return dmxFrameCount;
+}
+
+/**
+ * @brief Stands in for the TX interrupt: invokes the frame start callback during the break, then transmits the frame.
+ */
+static void transmitFrame()
+{
+    if (!activeMaster)
+        return;
+
+    activeMaster->processFrameStart();
+
+    DMX_FrameBuffer &frameBuffer = activeMaster->getBuffer();
+    dmxFrameCount++;
+    if (dmxFrameHook)
+    {
+        dmxFrameHook(&frameBuffer[0], frameBuffer.getBufferSize());
+    }
+}
+
+DMX_FrameBuffer::DMX_FrameBuffer(uint16_t buffer_size)
+{
+    m_refcount = (uint8_t *)malloc(sizeof(uint8_t));
+    *m_refcount = 1;
+
+    m_buffer = 0x0;
+    m_bufferSize = 0x0;
+    if (buffer_size >= DMX_MIN_FRAMESIZE && buffer_size <= DMX_MAX_FRAMESIZE)
+    {
+        m_buffer = (uint8_t *)calloc(buffer_size, 1);
+        if (m_buffer != NULL)
+        {
+            m_bufferSize = buffer_size;
+        }
+    }
+}
+
+DMX_FrameBuffer::DMX_FrameBuffer(DMX_FrameBuffer &buffer)
+{
+    m_refcount = buffer.m_refcount;
+    (*m_refcount)++;
+
+    m_buffer = buffer.m_buffer;
+    m_bufferSize = buffer.m_bufferSize;
+}
+
+DMX_FrameBuffer::~DMX_FrameBuffer(void)
+{
+    if (--(*m_refcount) == 0)
+    {
+        free(m_buffer);
+        free(m_refcount);
+    }
+}
+
+uint16_t DMX_FrameBuffer::getBufferSize(void)
+{
+    return m_bufferSize;
+}
+
+uint8_t DMX_FrameBuffer::getSlotValue(uint16_t index)
+{
+    return (index < m_bufferSize) ? m_buffer[index] : 0x0;
+}
+
+void DMX_FrameBuffer::setSlotValue(uint16_t index, uint8_t value)
+{
+    if (index < m_bufferSize)
+        m_buffer[index] = value;
+}
+
+void DMX_FrameBuffer::setSlotRange(uint16_t start, uint16_t end, uint8_t value)
+{
+    if (start < m_bufferSize && end < m_bufferSize && start < end)
+        memset(&m_buffer[start], value, end - start + 1);
+}
+
+void DMX_FrameBuffer::clear(void)
+{
+    memset(m_buffer, 0x0, m_bufferSize);
+}
+
+uint8_t &DMX_FrameBuffer::operator[](uint16_t index)
+{
+    return m_buffer[index];
+}
+
+DMX_Master::DMX_Master(DMX_FrameBuffer &buffer, int readEnablePin) : m_frameBuffer(buffer), m_autoBreak(1)
+{
+    setStartCode(DMX_START_CODE);
+    pinMode(readEnablePin, OUTPUT);
+}
+
+DMX_Master::DMX_Master(uint16_t maxChannel, int readEnablePin) : m_frameBuffer(maxChannel + DMX_STARTCODE_SIZE), m_autoBreak(1)
+{
+    setStartCode(DMX_START_CODE);
+    pinMode(readEnablePin, OUTPUT);
+}
+
+DMX_Master::~DMX_Master(void)
+{
+    disable();
+}
+
+DMX_FrameBuffer &DMX_Master::getBuffer(void)
+{
+    return m_frameBuffer;
+}
+
+void DMX_Master::setStartCode(uint8_t value)
+{
+    m_frameBuffer[0] = value;
+}
+
+void DMX_Master::setChannelValue(uint16_t channel, uint8_t value)
+{
+    if (channel > 0)
+        m_frameBuffer.setSlotValue(channel, value);
+}
+
+void DMX_Master::setChannelRange(uint16_t start, uint16_t end, uint8_t value)
+{
+    if (start > 0)
+        m_frameBuffer.setSlotRange(start, end, value);
+}
+
+void DMX_Master::enable(void)
+{
+    disable();
+    activeMaster = this;
+    if (m_autoBreak) // manual break mode sends a frame per breakAndContinue()
+    {
+        transmitTimer = hostAddTimer(transmitFrame, HOST_DMX_BREAK_US + (uint32_t)DMX_MAX_FRAMESIZE * HOST_DMX_SLOT_US); // the TX ISR always sends full frames, padding beyond the buffer with zeros
+    }
+}
+
+void DMX_Master::disable(void)
+{
+    if (transmitTimer != 0xFF)
+    {
+        hostRemoveTimer(transmitTimer);
+        transmitTimer = 0xFF;
+    }
+    if (activeMaster == this)
+    {
+        activeMaster = nullptr;
+    }
+}
+
+void (*DMX_Master::event_onFrameStart)(void);
+
+void DMX_Master::onFrameStart(void (*func)(void))
+{
+    event_onFrameStart = func;
+}
+
+void DMX_Master::processFrameStart(void)
+{
+    if (event_onFrameStart)
+        event_onFrameStart();
+}
+
+void DMX_Master::setAutoBreakMode(void) { m_autoBreak = 1; }
+void DMX_Master::setManualBreakMode(void) { m_autoBreak = 0; }
+uint8_t DMX_Master::autoBreakEnabled(void) { return m_autoBreak; }
+
+uint8_t DMX_Master::waitingBreak(void)
+{
+    return !m_autoBreak && activeMaster == this;
+}
+
+void DMX_Master::breakAndContinue(uint8_t breakLength_us)
+{
+    if (activeMaster != this)
+        return;
+
+    hostAdvanceTime(breakLength_us);
+    transmitFrame();
+}
@@ -0,0 +1,26 @@
+#ifndef ConceptineticsHost_h
+#define ConceptineticsHost_h
+#include <Conceptinetics.h>
+
+// Simulator hooks of the host implementation of DMX_Master (see ConceptineticsHost.cpp).
+// Instead of a USART, an enabled DMX_Master transmits through a host timer: every DMX frame period (break plus 44us for each of the 513 slots of a full frame, ~23ms)
+// the frame start callback is invoked, like the TX interrupt does during the break, and the frame is handed to the frame hook.
+
+#define HOST_DMX_BREAK_US 220
+#define HOST_DMX_SLOT_US 44
+
+/**
+ * @brief Registers a function that receives every DMX frame transmitted by the enabled DMX_Master.
+ *
+ * @param hook Function receiving the slots of the frame, including the start code at index 0, and the amount of slots.
+ */
+void hostOnDmxFrame(void (*hook)(const uint8_t *slots, uint16_t slotAmount));
+
+/**
+ * @brief Returns the amount of DMX frames transmitted so far.
+ *
+ * @return uint32_t Amount of frames.
+ */
+uint32_t hostGetDmxFrameCount();
+
+#endif
@@ -0,0 +1,123 @@
+#include "HD44780Host.h"
+#include "Wire.h"
+
+#define PIN_RS 0x01
+#define PIN_ENABLE 0x04
+
+static uint8_t lcdAddress = 0xFF;
+static uint8_t lastPins = 0;
+static bool fourBitMode = false;
+static bool highNibbleLatched = false;
+static uint8_t latchedByte = 0;
+static bool cgramSelected = false;
+static uint8_t address = 0;
+static bool displayOn = false;
+static char ddram[0x80];
+static uint32_t byteCount = 0;
+
+/**
+ * @brief Executes an instruction or writes a character, as the HD44780 does once a complete byte was latched.
+ */
+static void execute(uint8_t value, bool isCharacter)
+{
+    byteCount++;
+    if (isCharacter)
+    {
+        if (!cgramSelected) // glyph definitions are not modeled
+        {
+            if (value < 8)
+            {
+                ddram[address] = '0' + value; // custom glyphs by their index
+            }
+            else
+            {
+                ddram[address] = (value == 0xFF) ? '#' : value; // full block of the character ROM
+            }
+        }
+        address = (address + 1) & 0x7F;
+    }
+    else if (value & 0x80) // set DDRAM address
+    {
+        cgramSelected = false;
+        address = value & 0x7F;
+    }
+    else if (value & 0x40) // set CGRAM address
+    {
+        cgramSelected = true;
+        address = value & 0x3F;
+    }
+    else if (value & 0x08 && !(value & 0x30)) // display control
+    {
+        displayOn = value & 0x04;
+    }
+    else if (value == 0x01) // clear display
+    {
+        memset(ddram, ' ', sizeof(ddram));
+        address = 0;
+        cgramSelected = false;
+    }
+    else if ((value & 0xFE) == 0x02) // return home
+    {
+        address = 0;
+        cgramSelected = false;
+    }
+}
+
+static void onI2cTransmission(uint8_t deviceAddress, const uint8_t *data, uint8_t length)
+{
+    if (deviceAddress != lcdAddress)
+        return;
+
+    for (uint8_t index = 0; index < length; index++)
+    {
+        uint8_t pins = data[index];
+        if ((lastPins & PIN_ENABLE) && !(pins & PIN_ENABLE)) // falling edge of enable latches the nibble on D4..D7
+        {
+            uint8_t nibble = lastPins & 0xF0;
+            bool isCharacter = lastPins & PIN_RS;
+            if (!fourBitMode)
+            {
+                if (!isCharacter && (nibble & 0xF0) == 0x20) // function set with 4-bit interface
+                {
+                    fourBitMode = true;
+                }
+            }
+            else if (!highNibbleLatched)
+            {
+                latchedByte = nibble;
+                highNibbleLatched = true;
+            }
+            else
+            {
+                highNibbleLatched = false;
+                execute(latchedByte | (nibble >> 4), isCharacter);
+            }
+        }
+        lastPins = pins;
+    }
+}
+
+void hostAttachLcd(uint8_t deviceAddress)
+{
+    lcdAddress = deviceAddress;
+    memset(ddram, ' ', sizeof(ddram));
+    hostOnI2cTransmission(onI2cTransmission);
+}
+
+const char *hostGetLcdLine(uint8_t row)
+{
+    static char line[HOST_LCD_COLUMNS + 1];
+    memcpy(line, &ddram[row ? 0x40 : 0x00], HOST_LCD_COLUMNS);
+    line[HOST_LCD_COLUMNS] = '\0';
+    return line;
+}
+
+bool hostIsLcdOn()
+{
+    return displayOn;
+}
+
+uint32_t hostGetLcdByteCount()
+{
+    return byteCount;
+}
@@ -0,0 +1,37 @@
+#ifndef HD44780Host_h
+#define HD44780Host_h
+#include "Arduino.h"
+
+// Model of a 16x2 HD44780 character display behind a PCF8574 I2C backpack, for the host build.
+// Decodes the expander writes sent over I2C like the display does: nibbles are latched on the falling edge of the enable pin,
+// in 8-bit mode until the 4-bit mode instruction, in pairs afterwards. Keeps the display RAM, so tests can read what is shown.
+
+#define HOST_LCD_COLUMNS 16
+
+/**
+ * @brief Attaches the display to the I2C bus.
+ *
+ * @param address I2C address of the backpack.
+ */
+void hostAttachLcd(uint8_t address);
+
+/**
+ * @brief Returns the characters currently shown in a row of the display. Custom glyphs (characters 0 to 7) are shown as their index '0' to '7',
+ * the full block of the character ROM (0xFF) as '#'.
+ *
+ * @param row The row.
+ * @return const char* The visible characters of the row, zero-terminated.
+ */
+const char *hostGetLcdLine(uint8_t row);
+
+/**
+ * @brief Returns whether the display is turned on.
+ */
+bool hostIsLcdOn();
+
+/**
+ * @brief Returns the amount of bytes (characters and instructions) the display has received so far.
+ */
+uint32_t hostGetLcdByteCount();
+
+#endif
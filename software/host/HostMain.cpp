@@ -0,0 +1,206 @@
+// Headless harness of the host build: wires up the simulated peripherals of the board, runs setup() and loop()
+// for a given amount of virtual time and prints a summary of what the sketch did.
+//
+// Usage: phosphoros [--seconds N] [--ui-load] [--eeprom FILE]
+//   --seconds N    amount of virtual seconds to run the sketch for (default 10).
+//   --ui-load      presses the plus button every 200ms, so the user interface keeps redrawing.
+//   --eeprom FILE  loads the EEPROM from FILE, if it exists, and stores it there after the run, so settings survive across runs.
+//
+// All inputs are synthetic and derived from virtual time only, so two runs print exactly the same output.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "HostSimulation.h"
+#include "ConceptineticsHost.h"
+#include "HD44780Host.h"
+
+void setup();
+void loop();
+
+#define MSGEQ7_STROBE_PIN 7
+#define MSGEQ7_RESET_PIN 4
+#define BUTTON_LATCH_RESET_PIN 8
+#define BUTTON_PLUS_PIN 3
+#define LCD_ADDRESS 0x27
+#define BUTTON_PRESS_PERIOD_MS 200
+#define LOOP_STEP_US 4    // virtual time an iteration of loop() takes when no task is due
+#define SILENCE_MS 3000   // no audio on the jack for this long, so the noise probe of setup() sees the noise floor only
+#define BEAT_PERIOD_MS 500 // 120 BPM
+
+static const uint8_t BUTTON_PINS[] = {3, 5, 6, 9};
+static uint8_t selectedBand = 0;
+static uint32_t noiseState = 1;
+static uint32_t dmxChecksum = 2166136261u;
+static uint32_t firstDmxFrameUs = 0;
+
+/**
+ * @brief Models the multiplexer of the MSGEQ7: a reset pulse selects the first band, every falling edge on strobe selects the next one.
+ * Also models the button latches, which release when their reset line is pulled low.
+ */
+static void onDigitalWrite(uint8_t pin, uint8_t value)
+{
+    static uint8_t lastStrobe = LOW;
+
+    if (pin == MSGEQ7_RESET_PIN && value == HIGH)
+    {
+        selectedBand = 0;
+    }
+    else if (pin == MSGEQ7_STROBE_PIN)
+    {
+        if (lastStrobe == HIGH && value == LOW && hostGetPinLevel(MSGEQ7_RESET_PIN) == LOW)
+        {
+            selectedBand = (selectedBand + 1) % 7;
+        }
+        lastStrobe = value;
+    }
+    else if (pin == BUTTON_LATCH_RESET_PIN && value == LOW)
+    {
+        for (uint8_t button = 0; button < sizeof(BUTTON_PINS); button++)
+        {
+            hostSetPinLevel(BUTTON_PINS[button], LOW);
+        }
+    }
+}
+
+/**
+ * @brief Synthetic music: a noise floor, a kick drum on the low bands and a hi-hat on the high bands, 120 BPM.
+ */
+static uint16_t readAudio(uint8_t pin)
+{
+    noiseState = noiseState * 1664525u + 1013904223u; // LCG, deterministic
+    uint16_t level = 40 + (noiseState >> 26);          // noise floor of 40..103
+
+    uint32_t now = millis();
+    if (now < SILENCE_MS)
+    {
+        return level;
+    }
+
+    uint32_t beatPhase = (now - SILENCE_MS) % BEAT_PERIOD_MS;
+    if (selectedBand <= 1 && beatPhase < 150) // kick, decaying over 150ms
+    {
+        level += (150 - beatPhase) * 5;
+    }
+    else if (selectedBand >= 5 && (beatPhase + BEAT_PERIOD_MS / 2) % BEAT_PERIOD_MS < 40) // hi-hat on the off-beat
+    {
+        level += 400;
+    }
+    else if (selectedBand >= 2 && selectedBand <= 4)
+    {
+        level += 150 + 100 * ((now / 1000) % 3); // mids, changing every second
+    }
+
+    return min(level, 1023);
+}
+
+/**
+ * @brief Folds every transmitted DMX frame into a checksum (FNV-1a), which identifies the light output of a run.
+ * Also notes when the first frame was transmitted, i.e. how long the fixtures had to wait after startup.
+ */
+static void onDmxFrame(const uint8_t *slots, uint16_t slotAmount)
+{
+    if (hostGetDmxFrameCount() == 1)
+    {
+        firstDmxFrameUs = micros();
+    }
+    for (uint16_t slot = 0; slot < slotAmount; slot++)
+    {
+        dmxChecksum = (dmxChecksum ^ slots[slot]) * 16777619u;
+    }
+}
+
+/**
+ * @brief Loads the EEPROM from a file, if it exists. The EEPROM stays erased otherwise.
+ */
+static void loadEeprom(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return;
+
+    if (fread(hostGetEeprom(), 1, E2END + 1, file) != E2END + 1)
+    {
+        fprintf(stderr, "%s: not an EEPROM image of %d bytes\n", path, E2END + 1);
+        exit(1);
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Stores the EEPROM to a file.
+ */
+static void storeEeprom(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file || fwrite(hostGetEeprom(), 1, E2END + 1, file) != E2END + 1)
+    {
+        fprintf(stderr, "%s: can not write EEPROM image\n", path);
+        exit(1);
+    }
+    fclose(file);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t durationMs = 10000;
+    bool uiLoad = false;
+    const char *eepromPath = nullptr;
+    for (int argument = 1; argument < argc; argument++)
+    {
+        if (strcmp(argv[argument], "--seconds") == 0 && argument + 1 < argc)
+        {
+            durationMs = strtoul(argv[++argument], nullptr, 10) * 1000;
+        }
+        else if (strcmp(argv[argument], "--ui-load") == 0)
+        {
+            uiLoad = true;
+        }
+        else if (strcmp(argv[argument], "--eeprom") == 0 && argument + 1 < argc)
+        {
+            eepromPath = argv[++argument];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--seconds N] [--ui-load] [--eeprom FILE]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    hostOnDigitalWrite(onDigitalWrite);
+    hostOnAnalogRead(readAudio);
+    hostOnDmxFrame(onDmxFrame);
+    hostAttachLcd(LCD_ADDRESS);
+    if (eepromPath)
+    {
+        loadEeprom(eepromPath);
+    }
+
+    setup();
+    uint32_t bootEepromReads = hostGetEepromReadCount();
+    uint32_t nextPressMs = millis();
+    while (millis() < durationMs)
+    {
+        if (uiLoad && millis() >= nextPressMs)
+        {
+            hostSetPinLevel(BUTTON_PLUS_PIN, HIGH);
+            nextPressMs += BUTTON_PRESS_PERIOD_MS;
+        }
+        loop();
+        hostAdvanceTime(LOOP_STEP_US);
+    }
+
+    printf("virtual time: %lu ms\n", (unsigned long)millis());
+    printf("dmx frames:   %lu\n", (unsigned long)hostGetDmxFrameCount());
+    printf("dmx checksum: %08lx\n", (unsigned long)dmxChecksum);
+    printf("first frame:  %lu us\n", (unsigned long)firstDmxFrameUs);
+    printf("lcd (%s, %lu bytes):\n  [%s]\n", hostIsLcdOn() ? "on" : "off", (unsigned long)hostGetLcdByteCount(), hostGetLcdLine(0));
+    printf("  [%s]\n", hostGetLcdLine(1));
+    printf("eeprom writes: %lu\n", (unsigned long)hostGetEepromWriteCount());
+    printf("eeprom reads at boot: %lu\n", (unsigned long)bootEepromReads);
+    if (eepromPath)
+    {
+        storeEeprom(eepromPath);
+    }
+    return 0;
+}
@@ -0,0 +1,373 @@
+#include "Arduino.h"
+#include "HostSimulation.h"
+#include <avr/eeprom.h>
+#include <stdio.h>
+
+#define HOST_TIMER_AMOUNT 4
+
+static uint64_t timeUs = 0;
+static bool interruptsEnabled = true;
+static bool inInterrupt = false;
+
+static void (*timerCallback[HOST_TIMER_AMOUNT])() = {};
+static uint32_t timerPeriodUs[HOST_TIMER_AMOUNT] = {};
+static uint64_t timerDueUs[HOST_TIMER_AMOUNT] = {};
+
+static uint8_t pinLevel[HOST_PIN_AMOUNT] = {};
+static uint8_t pendingPinChanges = 0; // one bit per pin group, like PCIFR
+
+volatile uint8_t PCICR = 0;
+volatile uint8_t PCMSK0 = 0;
+volatile uint8_t PCMSK1 = 0;
+volatile uint8_t PCMSK2 = 0;
+
+HostPortRegister PINB(8, 6, HOST_REGISTER_PIN), PORTB(8, 6, HOST_REGISTER_PORT), DDRB(8, 6, HOST_REGISTER_DDR);
+HostPortRegister PINC(14, 6, HOST_REGISTER_PIN), PORTC(14, 6, HOST_REGISTER_PORT), DDRC(14, 6, HOST_REGISTER_DDR);
+HostPortRegister PIND(0, 8, HOST_REGISTER_PIN), PORTD(0, 8, HOST_REGISTER_PORT), DDRD(0, 8, HOST_REGISTER_DDR);
+
+static uint8_t eeprom[E2END + 1];
+static bool eepromErased = false; // erased on first access, as static arrays start out zeroed
+static uint64_t eepromReadyUs = 0;
+static uint32_t eepromWriteCount = 0;
+static uint32_t eepromReadCount = 0;
+
+// the sketch may or may not define these, undefined weak functions are null
+extern "C" void PCINT0_vect() __attribute__((weak));
+extern "C" void PCINT1_vect() __attribute__((weak));
+extern "C" void PCINT2_vect() __attribute__((weak));
+static void (*const pinChangeVectors[])() = {PCINT0_vect, PCINT1_vect, PCINT2_vect};
+static void (*digitalWriteHook)(uint8_t, uint8_t) = nullptr;
+static uint16_t (*analogReadSource)(uint8_t) = nullptr;
+
+/**
+ * @brief Calls the interrupt service routines of all pin groups with pending changes, lowest group first, unless interrupts are disabled.
+ */
+static void firePinChanges()
+{
+    while (pendingPinChanges && interruptsEnabled && !inInterrupt)
+    {
+        uint8_t group = 0;
+        while (!(pendingPinChanges & _BV(group)))
+        {
+            group++;
+        }
+        pendingPinChanges &= ~_BV(group);
+
+        if (pinChangeVectors[group])
+        {
+            inInterrupt = true;
+            pinChangeVectors[group]();
+            inInterrupt = false;
+        }
+    }
+}
+
+/**
+ * @brief Fires the earliest timer that is due at or before the supplied time, like the interrupt controller would.
+ *
+ * @param untilUs Latest due time to consider.
+ * @return true if a timer was fired.
+ */
+static bool fireNextTimer(uint64_t untilUs)
+{
+    uint8_t nextTimer = HOST_TIMER_AMOUNT;
+    for (uint8_t timerId = 0; timerId < HOST_TIMER_AMOUNT; timerId++)
+    {
+        if (timerCallback[timerId] && timerDueUs[timerId] <= untilUs && (nextTimer == HOST_TIMER_AMOUNT || timerDueUs[timerId] < timerDueUs[nextTimer]))
+        {
+            nextTimer = timerId;
+        }
+    }
+
+    if (nextTimer == HOST_TIMER_AMOUNT)
+        return false;
+
+    if (timerDueUs[nextTimer] > timeUs)
+    {
+        timeUs = timerDueUs[nextTimer];
+    }
+    while (timerDueUs[nextTimer] <= timeUs) // a timer that was held back by noInterrupts() fires once, like a pending interrupt flag
+    {
+        timerDueUs[nextTimer] += timerPeriodUs[nextTimer];
+    }
+
+    inInterrupt = true;
+    timerCallback[nextTimer]();
+    inInterrupt = false;
+    firePinChanges(); // pin changes caused by the timer
+    return true;
+}
+
+void hostAdvanceTime(uint32_t us)
+{
+    uint64_t targetUs = timeUs + us;
+    while (interruptsEnabled && !inInterrupt && fireNextTimer(targetUs))
+    {
+    }
+    timeUs = targetUs;
+}
+
+uint8_t hostAddTimer(void (*callback)(), uint32_t periodUs)
+{
+    for (uint8_t timerId = 0; timerId < HOST_TIMER_AMOUNT; timerId++)
+    {
+        if (!timerCallback[timerId])
+        {
+            timerCallback[timerId] = callback;
+            timerPeriodUs[timerId] = max(periodUs, 1);
+            timerDueUs[timerId] = timeUs + periodUs;
+            return timerId;
+        }
+    }
+
+    fprintf(stderr, "host: out of timers\n");
+    abort();
+}
+
+void hostRemoveTimer(uint8_t timerId)
+{
+    timerCallback[timerId] = nullptr;
+}
+
+void hostSetPinLevel(uint8_t pin, uint8_t value)
+{
+    if (pin >= HOST_PIN_AMOUNT)
+        return;
+
+    uint8_t level = value ? HIGH : LOW;
+    if (pinLevel[pin] == level)
+        return;
+
+    pinLevel[pin] = level;
+    uint8_t group = digitalPinToPCICRbit(pin);
+    if ((PCICR & _BV(group)) && (*digitalPinToPCMSK(pin) & _BV(digitalPinToPCMSKbit(pin))))
+    {
+        pendingPinChanges |= _BV(group);
+        firePinChanges();
+    }
+}
+
+uint8_t hostGetPinLevel(uint8_t pin)
+{
+    return (pin < HOST_PIN_AMOUNT) ? pinLevel[pin] : LOW;
+}
+
+void hostOnDigitalWrite(void (*hook)(uint8_t pin, uint8_t value))
+{
+    digitalWriteHook = hook;
+}
+
+void hostOnAnalogRead(uint16_t (*source)(uint8_t pin))
+{
+    analogReadSource = source;
+}
+
+uint32_t millis()
+{
+    return timeUs / 1000;
+}
+
+uint32_t micros()
+{
+    return timeUs;
+}
+
+void delay(uint32_t ms)
+{
+    hostAdvanceTime(ms * 1000);
+}
+
+void delayMicroseconds(uint16_t us)
+{
+    hostAdvanceTime(us);
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (mode == INPUT_PULLUP)
+    {
+        hostSetPinLevel(pin, HIGH);
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    hostSetPinLevel(pin, value);
+    if (digitalWriteHook)
+    {
+        digitalWriteHook(pin, value ? HIGH : LOW);
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    return hostGetPinLevel(pin);
+}
+
+int analogRead(uint8_t pin)
+{
+    hostAdvanceTime(HOST_ANALOG_READ_US);
+    if (pin >= A0)
+    {
+        pin -= A0;
+    }
+    return analogReadSource ? min(analogReadSource(pin), 1023) : 0;
+}
+
+void noInterrupts()
+{
+    interruptsEnabled = false;
+}
+
+void interrupts()
+{
+    interruptsEnabled = true;
+    firePinChanges();
+    while (!inInterrupt && fireNextTimer(timeUs))
+    {
+    }
+}
+
+HostPortRegister::operator uint8_t() const
+{
+    if (_kind == HOST_REGISTER_DDR)
+        return _value;
+
+    uint8_t levels = 0;
+    for (uint8_t bit = 0; bit < _pinAmount; bit++)
+    {
+        levels |= hostGetPinLevel(_firstPin + bit) << bit;
+    }
+    return levels;
+}
+
+HostPortRegister &HostPortRegister::operator=(uint8_t value)
+{
+    if (_kind == HOST_REGISTER_DDR)
+    {
+        _value = value;
+        return *this;
+    }
+
+    uint8_t levels = *this;
+    uint8_t changes = (_kind == HOST_REGISTER_PIN) ? value : (value ^ levels); // writing ones to PINx toggles the pins
+    for (uint8_t bit = 0; bit < _pinAmount; bit++)
+    {
+        if (changes & _BV(bit))
+        {
+            digitalWrite(_firstPin + bit, !(levels & _BV(bit)));
+        }
+    }
+    return *this;
+}
+
+String::String(long value, unsigned char base) : String()
+{
+    if (value < 0)
+    {
+        _buffer = "-";
+        _buffer += String((unsigned long)-value, base).c_str();
+        return;
+    }
+    _buffer = String((unsigned long)value, base).c_str();
+}
+
+String::String(unsigned long value, unsigned char base) : String()
+{
+    do
+    {
+        uint8_t digit = value % base;
+        _buffer.insert(_buffer.begin(), (char)(digit < 10 ? '0' + digit : 'A' + digit - 10));
+        value /= base;
+    } while (value > 0);
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+    if (beginIndex > endIndex)
+    {
+        unsigned int swap = beginIndex;
+        beginIndex = endIndex;
+        endIndex = swap;
+    }
+    if (beginIndex >= length())
+        return String();
+
+    return String(_buffer.substr(beginIndex, min(endIndex, length()) - beginIndex).c_str());
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+    while (size--)
+    {
+        written += write(*buffer++);
+    }
+    return written;
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write(buffer);
+}
+
+uint8_t *hostGetEeprom()
+{
+    if (!eepromErased)
+    {
+        memset(eeprom, 0xFF, sizeof(eeprom));
+        eepromErased = true;
+    }
+    return eeprom;
+}
+
+uint32_t hostGetEepromWriteCount()
+{
+    return eepromWriteCount;
+}
+
+uint32_t hostGetEepromReadCount()
+{
+    return eepromReadCount;
+}
+
+bool hostEepromIsReady()
+{
+    return timeUs >= eepromReadyUs;
+}
+
+/**
+ * @brief Waits for the EEPROM to finish the last write, like the avr-libc functions do.
+ */
+static void waitForEeprom()
+{
+    if (timeUs < eepromReadyUs)
+    {
+        hostAdvanceTime(eepromReadyUs - timeUs);
+    }
+}
+
+uint8_t eeprom_read_byte(const uint8_t *address)
+{
+    waitForEeprom();
+    eepromReadCount++;
+    return hostGetEeprom()[(uintptr_t)address & E2END];
+}
+
+void eeprom_write_byte(uint8_t *address, uint8_t value)
+{
+    waitForEeprom();
+    hostGetEeprom()[(uintptr_t)address & E2END] = value;
+    eepromReadyUs = timeUs + HOST_EEPROM_WRITE_US;
+    eepromWriteCount++;
+}
+
+void eeprom_update_byte(uint8_t *address, uint8_t value)
+{
+    if (eeprom_read_byte(address) != value)
+    {
+        eeprom_write_byte(address, value);
+    }
+}
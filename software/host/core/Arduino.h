@@ -0,0 +1,152 @@
+#ifndef Arduino_h
+#define Arduino_h
+
+// Mock of the Arduino core for building the sketch on a Linux host.
+// Time is virtual and only advances through HostSimulation (see HostSimulation.h), so every run is deterministic.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <type_traits>
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+// pin change interrupt registers of a pin, as defined by pins_arduino.h of the Uno
+#define digitalPinToPCICR(p) (((p) >= 0 && (p) <= 21) ? (&PCICR) : ((volatile uint8_t *)0))
+#define digitalPinToPCICRbit(p) (((p) <= 7) ? 2 : (((p) <= 13) ? 0 : 1))
+#define digitalPinToPCMSK(p) (((p) <= 7) ? (&PCMSK2) : (((p) <= 13) ? (&PCMSK0) : (((p) <= 21) ? (&PCMSK1) : ((volatile uint8_t *)0))))
+#define digitalPinToPCMSKbit(p) (((p) <= 7) ? (p) : (((p) <= 13) ? ((p) - 8) : ((p) - 14)))
+
+#define DEC 10
+#define HEX 16
+
+// The AVR core implements these as macros, templates keep the same usual arithmetic conversions without breaking the standard library.
+template <typename A, typename B>
+constexpr typename std::common_type<A, B>::type min(A a, B b)
+{
+    return (a < b) ? a : b;
+}
+
+template <typename A, typename B>
+constexpr typename std::common_type<A, B>::type max(A a, B b)
+{
+    return (a > b) ? a : b;
+}
+
+template <typename V, typename L, typename H>
+constexpr V constrain(V value, L low, H high)
+{
+    return (value < low) ? low : ((value > high) ? high : value);
+}
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint16_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+void noInterrupts();
+void interrupts();
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+
+class String
+{
+public:
+    String() {}
+    String(const char *cstr) : _buffer(cstr ? cstr : "") {}
+    String(const __FlashStringHelper *str) : _buffer(reinterpret_cast<const char *>(str)) {}
+    String(char c) : _buffer(1, c) {}
+    String(unsigned char value, unsigned char base = DEC) : String((unsigned long)value, base) {}
+    String(int value, unsigned char base = DEC) : String((long)value, base) {}
+    String(unsigned int value, unsigned char base = DEC) : String((unsigned long)value, base) {}
+    String(long value, unsigned char base = DEC);
+    String(unsigned long value, unsigned char base = DEC);
+
+    unsigned int length() const { return _buffer.length(); }
+    unsigned char reserve(unsigned int size)
+    {
+        _buffer.reserve(size);
+        return 1;
+    }
+    const char *c_str() const { return _buffer.c_str(); }
+    char charAt(unsigned int index) const { return index < _buffer.length() ? _buffer[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    String substring(unsigned int beginIndex) const { return substring(beginIndex, length()); }
+    String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+    String &operator+=(const String &rhs)
+    {
+        _buffer += rhs._buffer;
+        return *this;
+    }
+    String &operator+=(const char *rhs) { return *this += String(rhs); }
+    String &operator+=(char rhs) { return *this += String(rhs); }
+    friend String operator+(const String &lhs, const String &rhs)
+    {
+        String result = lhs;
+        result += rhs;
+        return result;
+    }
+    bool operator==(const String &rhs) const { return _buffer == rhs._buffer; }
+    bool operator!=(const String &rhs) const { return _buffer != rhs._buffer; }
+
+private:
+    std::string _buffer;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return write(reinterpret_cast<const uint8_t *>(str), strlen(str)); }
+
+    size_t print(const __FlashStringHelper *str) { return write(reinterpret_cast<const char *>(str)); }
+    size_t print(const String &str) { return write(str.c_str()); }
+    size_t print(const char *str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(int value, int base = DEC) { return print((long)value, base); }
+    size_t print(unsigned int value, int base = DEC) { return print((unsigned long)value, base); }
+    size_t print(long value, int base = DEC) { return print(String(value, (unsigned char)base)); }
+    size_t print(unsigned long value, int base = DEC) { return print(String(value, (unsigned char)base)); }
+    size_t print(double value, int digits = 2);
+
+    size_t println() { return write("\r\n"); }
+    template <typename T>
+    size_t println(T value)
+    {
+        size_t written = print(value);
+        return written + println();
+    }
+};
+
+#endif
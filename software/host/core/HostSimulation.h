@@ -0,0 +1,93 @@
+#ifndef HostSimulation_h
+#define HostSimulation_h
+#include "Arduino.h"
+
+// Control over the simulated board of the host build.
+//
+// Time is virtual: it only advances when the sketch waits (delay(), delayMicroseconds()), when a simulated peripheral
+// takes time (e.g. analogRead() takes one ADC conversion, see HOST_ANALOG_READ_US) or when the host harness advances it.
+// Timers registered via hostAddTimer() stand in for interrupts. They fire while time advances, unless interrupts
+// are disabled via noInterrupts(), in which case they fire as soon as interrupts() is called.
+// Pin change interrupts are modeled as well: once enabled for a pin via PCICR and PCMSKx, every change of the pin's level
+// calls ISR(PCINTx_vect) of its pin group, again held back while interrupts are disabled.
+// The EEPROM starts out erased (all 0xFF) and keeps its contents until the harness changes them via hostGetEeprom().
+
+#define HOST_ANALOG_READ_US 112 // 13 ADC clocks at 16MHz / 128
+#define HOST_PIN_AMOUNT 20
+#define HOST_EEPROM_WRITE_US 3400 // erase and write of an EEPROM byte
+
+/**
+ * @brief Advances virtual time, firing all timers that become due on the way.
+ *
+ * @param us Amount of microseconds to advance.
+ */
+void hostAdvanceTime(uint32_t us);
+
+/**
+ * @brief Registers a periodic timer, standing in for an interrupt source (e.g. the DMX TX interrupt).
+ *
+ * @param callback Function called once per period.
+ * @param periodUs Period of the timer, in us.
+ * @return uint8_t Id of the timer.
+ */
+uint8_t hostAddTimer(void (*callback)(), uint32_t periodUs);
+
+/**
+ * @brief Stops a timer registered via hostAddTimer().
+ *
+ * @param timerId Id of the timer.
+ */
+void hostRemoveTimer(uint8_t timerId);
+
+/**
+ * @brief Sets the level digitalRead() returns for a pin. Raises a pin change interrupt if the level changes and the interrupt is enabled.
+ *
+ * @param pin The pin.
+ * @param value HIGH or LOW.
+ */
+void hostSetPinLevel(uint8_t pin, uint8_t value);
+
+/**
+ * @brief Returns the level last written to a pin via digitalWrite(), or set via hostSetPinLevel().
+ *
+ * @param pin The pin.
+ * @return uint8_t HIGH or LOW.
+ */
+uint8_t hostGetPinLevel(uint8_t pin);
+
+/**
+ * @brief Registers a function that is called on every digitalWrite(), so simulated peripherals can react to pin changes.
+ *
+ * @param hook Function receiving pin and written value.
+ */
+void hostOnDigitalWrite(void (*hook)(uint8_t pin, uint8_t value));
+
+/**
+ * @brief Registers the function that provides the values returned by analogRead().
+ *
+ * @param source Function receiving the pin (A0..A5 or 0..5) and returning a 10-bit value.
+ */
+void hostOnAnalogRead(uint16_t (*source)(uint8_t pin));
+
+/**
+ * @brief Returns the contents of the simulated EEPROM, so the harness can load and keep them across runs.
+ *
+ * @return uint8_t* The E2END + 1 bytes of the EEPROM.
+ */
+uint8_t *hostGetEeprom();
+
+/**
+ * @brief Returns the amount of EEPROM bytes written so far. Writes of eeprom_update_byte() that did not change the byte are not counted.
+ *
+ * @return uint32_t Amount of bytes written.
+ */
+uint32_t hostGetEepromWriteCount();
+
+/**
+ * @brief Returns the amount of EEPROM bytes read so far, including the reads eeprom_update_byte() compares with.
+ *
+ * @return uint32_t Amount of bytes read.
+ */
+uint32_t hostGetEepromReadCount();
+
+#endif
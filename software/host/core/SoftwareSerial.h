@@ -0,0 +1,20 @@
+#ifndef SoftwareSerial_h
+#define SoftwareSerial_h
+#include "Arduino.h"
+#include <stdio.h>
+
+// Fake of the SoftwareSerial library for the host build. Everything written is sent to stdout, without taking virtual time.
+
+class SoftwareSerial : public Print
+{
+public:
+    SoftwareSerial(uint8_t receivePin, uint8_t transmitPin) {}
+    void begin(long speed) {}
+    size_t write(uint8_t value) override
+    {
+        return (putchar(value) == EOF) ? 0 : 1;
+    }
+    using Print::write;
+};
+
+#endif
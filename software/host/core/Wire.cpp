@@ -0,0 +1,60 @@
+#include "Wire.h"
+#include "HostSimulation.h"
+
+TwoWire Wire;
+static void (*i2cTransmissionHook)(uint8_t, const uint8_t *, uint8_t) = nullptr;
+
+void hostOnI2cTransmission(void (*hook)(uint8_t address, const uint8_t *data, uint8_t length))
+{
+    i2cTransmissionHook = hook;
+}
+
+TwoWire::TwoWire() : _clock(100000), _address(0), _length(0)
+{
+}
+
+void TwoWire::begin()
+{
+}
+
+void TwoWire::setClock(uint32_t clock)
+{
+    _clock = clock;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+    _address = address;
+    _length = 0;
+}
+
+size_t TwoWire::write(uint8_t value)
+{
+    if (_length == BUFFER_LENGTH)
+        return 0;
+
+    _buffer[_length++] = value;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t length)
+{
+    size_t written = 0;
+    while (written < length && write(data[written]))
+    {
+        written++;
+    }
+    return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop)
+{
+    uint32_t bits = 2 + (1 + _length) * 9; // start and stop condition, address and data bytes with their acknowledge bits
+    hostAdvanceTime(bits * 1000000ul / _clock);
+    if (i2cTransmissionHook)
+    {
+        i2cTransmissionHook(_address, _buffer, _length);
+    }
+    _length = 0;
+    return 0;
+}
@@ -0,0 +1,37 @@
+#ifndef Wire_h
+#define Wire_h
+#include "Arduino.h"
+
+// Fake of the Wire library for the host build. Transmissions are handed to the I2C device hook (see hostOnI2cTransmission())
+// and take the virtual time the transfer takes on the bus: 9 bits per byte, including the address byte, plus start and stop condition.
+
+#define BUFFER_LENGTH 32
+
+class TwoWire
+{
+public:
+    TwoWire();
+    void begin();
+    void setClock(uint32_t clock);
+    void beginTransmission(uint8_t address);
+    size_t write(uint8_t value);
+    size_t write(const uint8_t *data, size_t length);
+    uint8_t endTransmission(bool sendStop = true);
+
+private:
+    uint32_t _clock;
+    uint8_t _address;
+    uint8_t _buffer[BUFFER_LENGTH];
+    uint8_t _length;
+};
+
+extern TwoWire Wire;
+
+/**
+ * @brief Registers the function that receives all I2C transmissions, standing in for the devices on the bus.
+ *
+ * @param hook Function receiving the address and the bytes of a transmission.
+ */
+void hostOnI2cTransmission(void (*hook)(uint8_t address, const uint8_t *data, uint8_t length));
+
+#endif
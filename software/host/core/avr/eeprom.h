@@ -0,0 +1,17 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+// The EEPROM of the ATmega328P, with the avr-libc functions the sketch uses. Like on the hardware, writing a byte keeps the EEPROM busy
+// for HOST_EEPROM_WRITE_US (see HostSimulation.h), and accessing it while busy waits until the write finished.
+
+#include <stdint.h>
+#include <avr/io.h>
+
+uint8_t eeprom_read_byte(const uint8_t *address);
+void eeprom_write_byte(uint8_t *address, uint8_t value);
+void eeprom_update_byte(uint8_t *address, uint8_t value);
+bool hostEepromIsReady();
+
+#define eeprom_is_ready() hostEepromIsReady()
+
+#endif
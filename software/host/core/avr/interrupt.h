@@ -0,0 +1,12 @@
+#ifndef HOST_INTERRUPT_H
+#define HOST_INTERRUPT_H
+
+// Interrupt service routines are plain functions on the host, the simulation calls the ones the sketch defines (see HostSimulation.h).
+
+#define ISR(vector) extern "C" void vector()
+
+#define PCINT0_vect hostPcint0Vector
+#define PCINT1_vect hostPcint1Vector
+#define PCINT2_vect hostPcint2Vector
+
+#endif
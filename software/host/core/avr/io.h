@@ -0,0 +1,47 @@
+#ifndef HOST_IO_H
+#define HOST_IO_H
+
+// The registers of the ATmega328P the sketch accesses directly. Port registers are objects acting on the simulated pins,
+// the others are plain variables the host simulation acts on like the hardware does, see HostSimulation.h for which ones are modeled.
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+#define E2END 0x3FF // last EEPROM address
+
+extern volatile uint8_t PCICR;  // pin change interrupt enable, one bit per pin group
+extern volatile uint8_t PCMSK0; // pin change masks of the groups: pins 8..13, A0..A5 and 0..7
+extern volatile uint8_t PCMSK1;
+extern volatile uint8_t PCMSK2;
+
+#define HOST_REGISTER_PIN 0
+#define HOST_REGISTER_PORT 1
+#define HOST_REGISTER_DDR 2
+
+/**
+ * @brief Stand-in for the PINx, PORTx and DDRx registers of a port, bit n maps to the simulated pin `firstPin + n`.
+ * Reading PINx or PORTx returns the levels of the pins, writing PORTx changes the levels of the pins whose bits changed via digitalWrite(),
+ * writing PINx toggles them. The simulation does not tell inputs from outputs, so writing back the level read from an input pin has no effect.
+ * DDRx only stores what is written.
+ */
+class HostPortRegister
+{
+public:
+    constexpr HostPortRegister(uint8_t firstPin, uint8_t pinAmount, uint8_t kind) : _firstPin(firstPin), _pinAmount(pinAmount), _kind(kind), _value(0) {}
+    operator uint8_t() const;
+    HostPortRegister &operator=(uint8_t value);
+    HostPortRegister &operator|=(uint8_t mask) { return *this = (uint8_t)(*this | mask); }
+    HostPortRegister &operator&=(uint8_t mask) { return *this = (uint8_t)(*this & mask); }
+
+private:
+    uint8_t _firstPin;
+    uint8_t _pinAmount;
+    uint8_t _kind;
+    uint8_t _value; // DDRx only
+};
+
+extern HostPortRegister PINB, PORTB, DDRB; // pins 8..13
+extern HostPortRegister PINC, PORTC, DDRC; // pins 14..19 (A0..A5)
+extern HostPortRegister PIND, PORTD, DDRD; // pins 0..7
+
+#endif
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""
+Turns the sketch into a plain C++ translation unit, the way the Arduino IDE does before compiling:
+includes Arduino.h and declares a prototype of every function defined in the sketch directly after its includes,
+so functions may be used before they are defined.
+
+Usage: prototypes.py <sketch.ino> > sketch.cpp
+"""
+import re
+import sys
+
+FUNCTION_DEFINITION = re.compile(r'^[A-Za-z_][\w:<>,\s\*&]*\s[\*&]?\w+\s*\(.*\)\s*$')
+
+
+def main():
+    sketchPath = sys.argv[1]
+    with open(sketchPath) as sketchFile:
+        lines = sketchFile.read().split('\n')
+
+    prototypes = []
+    for index, line in enumerate(lines):
+        isDefinition = FUNCTION_DEFINITION.match(line) and index + 1 < len(lines) and lines[index + 1].strip() == '{'
+        if isDefinition and not line.startswith(('return', 'else')):
+            prototypes.append(line.strip() + ';')
+
+    # prototypes go behind the leading block of includes, so all types they use are declared
+    includeEnd = 0
+    while includeEnd < len(lines) and lines[includeEnd].startswith('#include'):
+        includeEnd += 1
+
+    output = ['#include <Arduino.h>', '#line 1 "%s"' % sketchPath]
+    output += lines[:includeEnd]
+    output += prototypes
+    output.append('#line %d "%s"' % (includeEnd + 1, sketchPath))
+    output += lines[includeEnd:]
+    print('\n'.join(output))
+
+
+if __name__ == '__main__':
+    main()
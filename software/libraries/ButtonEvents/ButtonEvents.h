@@ -0,0 +1,117 @@
+#ifndef ButtonEvents_h
+#define ButtonEvents_h
+#include <ButtonGroup.h>
+#include "Arduino.h"
+
+#define BUTTON_EVENT_QUEUE_SIZE 8 // must be a power of two, so queue indices wrap with a mask
+
+// types of button events
+#define BUTTON_PRESS 0x1
+#define BUTTON_HOLD 0x2
+#define BUTTON_RELEASE 0x3
+#define BUTTON_DOUBLE_PRESS 0x4
+
+/**
+ * @brief Something that happened to a button, see ButtonEvents.
+ */
+struct ButtonEvent
+{
+    uint8_t button;     // index of the button in the pin list of the ButtonGroup
+    uint8_t type;       // BUTTON_PRESS, BUTTON_HOLD, BUTTON_RELEASE or BUTTON_DOUBLE_PRESS
+    uint16_t timestamp; // millis() at which the event happened, truncated to 16 bits
+};
+
+/**
+ * @brief Turns latched buttons into a queue of timestamped events, driven by pin change interrupts instead of polling once per frame.
+ * The buttons are latched in hardware: a press pulls the button's pin HIGH and keeps it there until the latch is reset, see ButtonGroup.
+ * While a button is held down, resetting its latch has no effect, so its pin stays HIGH.
+ *
+ * Presses are detected by onPinChange(), which is meant to be called from the pin change interrupts of the button pins.
+ * A press therefore gets the timestamp of the moment it happened, no matter how busy the main loop is.
+ * Whether pressed buttons are still held is probed by update(), which resets the latches of held buttons and checks which of them stay HIGH.
+ * Releases are therefore timestamped with a resolution of the update period, holds are timed from the press.
+ *
+ * Events:
+ * - BUTTON_PRESS when a button is pressed.
+ * - BUTTON_DOUBLE_PRESS instead of BUTTON_PRESS if the button was pressed less than `doublePressMs` before.
+ * - BUTTON_HOLD `holdDelayMs` after the press, then every `holdRepeatMs`, until the button is released.
+ * - BUTTON_RELEASE once update() finds the button released.
+ *
+ * Events are queued in a ring of BUTTON_EVENT_QUEUE_SIZE events. The producers (the interrupt and update()) never interrupt each other,
+ * as update() disables interrupts while it queues, and the only consumer read() runs in the main loop, so reading needs no locking. Events that do not fit into a full queue are dropped.
+ *
+ * @tparam BUTTONS The ButtonGroup the buttons are read from, e.g. `ButtonGroup<8, 3, 5>` for two buttons on pins 3 and 5 with a latch reset on pin 8.
+ */
+template <class BUTTONS>
+class ButtonEvents
+{
+public:
+    /**
+     * @brief Construct a new ButtonEvents object. The pins are not configured until init() is called.
+     *
+     * @param holdDelayMs Time after a press at which the first BUTTON_HOLD event is queued.
+     * @param holdRepeatMs Time between further BUTTON_HOLD events while the button stays held.
+     * @param doublePressMs Presses following a press of the same button within this time are queued as BUTTON_DOUBLE_PRESS.
+     */
+    ButtonEvents(uint16_t holdDelayMs, uint16_t holdRepeatMs, uint16_t doublePressMs);
+
+    /**
+     * @brief Configures the button pins as inputs and the reset pin as output, resets the latches and enables the pin change interrupts of the button pins.
+     * The interrupt service routines (e.g. PCINT0_vect and PCINT2_vect on the ATmega328P) must call onPinChange().
+     */
+    void init();
+
+    /**
+     * @brief Reads the button pins and queues a press for every button that went HIGH. Call this from the pin change interrupts of the button pins.
+     * It may also be called from the main loop instead, e.g. if the interrupts are taken by another library; presses are then timestamped when this is called.
+     * Must not be called from other interrupts, as it must not interrupt update().
+     */
+    void onPinChange();
+
+    /**
+     * @brief Probes whether pressed buttons are still held, by resetting their latches, and queues the resulting release and hold events.
+     * Returns immediately if no button is pressed. Call this regularly, the period determines how precisely releases are timestamped.
+     */
+    void update();
+
+    /**
+     * @brief Takes the oldest event from the queue.
+     *
+     * @param event Receives the event.
+     * @return true If an event was taken.
+     * @return false If the queue is empty.
+     */
+    bool read(ButtonEvent &event);
+
+private:
+    uint16_t _holdDelayMs;
+    uint16_t _holdRepeatMs;
+    uint16_t _doublePressMs;
+    // Bit mask of the buttons which were pressed and not released yet.
+    volatile uint8_t _pressedButtons;
+    // Time of the last press of each button, used to detect double presses.
+    uint16_t _pressTimestamps[BUTTONS::AMOUNT];
+    // Time at which the next BUTTON_HOLD event of each pressed button is due.
+    uint16_t _holdTimestamps[BUTTONS::AMOUNT];
+    ButtonEvent _queue[BUTTON_EVENT_QUEUE_SIZE];
+    // Index the next event is written to, only changed by producers.
+    volatile uint8_t _queueHead;
+    // Index the next event is read from, only changed by read().
+    volatile uint8_t _queueTail;
+
+    /**
+     * @brief Queues a press (or double press) for every button that is HIGH but not pressed yet. Must not interrupt other producers.
+     *
+     * @param buttons Bit mask of the buttons whose pins are HIGH.
+     * @param timestamp Current time.
+     */
+    void registerPresses(uint8_t buttons, uint16_t timestamp);
+
+    /**
+     * @brief Adds an event to the queue, unless it is full. Must not interrupt other producers.
+     */
+    void push(uint8_t button, uint8_t type, uint16_t timestamp);
+};
+
+#include "ButtonEvents.tpp"
+#endif
@@ -0,0 +1,107 @@
+#include "ButtonEvents.h"
+#include "Arduino.h"
+
+template <class BUTTONS>
+ButtonEvents<BUTTONS>::ButtonEvents(uint16_t holdDelayMs, uint16_t holdRepeatMs, uint16_t doublePressMs) : _holdDelayMs(holdDelayMs), _holdRepeatMs(holdRepeatMs), _doublePressMs(doublePressMs), _pressedButtons(0), _queueHead(0), _queueTail(0)
+{
+    for (uint8_t button = 0; button < BUTTONS::AMOUNT; button++)
+    {
+        _pressTimestamps[button] = -doublePressMs; // so the first press is not taken for a double press
+        _holdTimestamps[button] = 0;
+    }
+}
+
+template <class BUTTONS>
+void ButtonEvents<BUTTONS>::init()
+{
+    BUTTONS::init();
+    BUTTONS::enablePinChangeInterrupts();
+}
+
+template <class BUTTONS>
+void ButtonEvents<BUTTONS>::onPinChange()
+{
+    registerPresses(BUTTONS::read(), millis());
+}
+
+template <class BUTTONS>
+void ButtonEvents<BUTTONS>::update()
+{
+    if (!_pressedButtons) // released buttons are LOW, the interrupt reports when they go HIGH
+        return;
+
+    uint16_t now = millis();
+    noInterrupts(); // the pulse makes the pins of held buttons drop shortly, which must not be taken for a new press
+    BUTTONS::resetLatches();
+    uint8_t buttons = BUTTONS::read();
+
+    uint8_t releasedButtons = _pressedButtons & ~buttons; // latches that did not set again, so these buttons are no longer held
+    _pressedButtons &= buttons;
+    for (uint8_t button = 0; button < BUTTONS::AMOUNT; button++)
+    {
+        if (releasedButtons & (1 << button))
+        {
+            push(button, BUTTON_RELEASE, now);
+        }
+        else if ((_pressedButtons & (1 << button)) && (int16_t)(now - _holdTimestamps[button]) >= 0)
+        {
+            _holdTimestamps[button] += _holdRepeatMs;
+            push(button, BUTTON_HOLD, now);
+        }
+    }
+    registerPresses(buttons, now); // buttons pressed while probing
+    interrupts();
+}
+
+template <class BUTTONS>
+bool ButtonEvents<BUTTONS>::read(ButtonEvent &event)
+{
+    if (_queueTail == _queueHead)
+        return false;
+
+    __asm__ __volatile__("" ::: "memory"); // read the event only after seeing the head that covers it
+    event = _queue[_queueTail];
+    _queueTail = (_queueTail + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+    return true;
+}
+
+template <class BUTTONS>
+void ButtonEvents<BUTTONS>::registerPresses(uint8_t buttons, uint16_t timestamp)
+{
+    uint8_t newPresses = buttons & ~_pressedButtons; // pins of pressed buttons stay HIGH until they are released
+    if (!newPresses)
+        return;
+
+    for (uint8_t button = 0; button < BUTTONS::AMOUNT; button++)
+    {
+        if (!(newPresses & (1 << button)))
+            continue;
+
+        if ((uint16_t)(timestamp - _pressTimestamps[button]) < _doublePressMs)
+        {
+            push(button, BUTTON_DOUBLE_PRESS, timestamp);
+            _pressTimestamps[button] = timestamp - _doublePressMs; // a third press starts over
+        }
+        else
+        {
+            push(button, BUTTON_PRESS, timestamp);
+            _pressTimestamps[button] = timestamp;
+        }
+        _holdTimestamps[button] = timestamp + _holdDelayMs;
+    }
+    _pressedButtons |= newPresses;
+}
+
+template <class BUTTONS>
+void ButtonEvents<BUTTONS>::push(uint8_t button, uint8_t type, uint16_t timestamp)
+{
+    uint8_t nextHead = (_queueHead + 1) & (BUTTON_EVENT_QUEUE_SIZE - 1);
+    if (nextHead == _queueTail) // queue is full
+        return;
+
+    _queue[_queueHead].button = button;
+    _queue[_queueHead].type = type;
+    _queue[_queueHead].timestamp = timestamp;
+    __asm__ __volatile__("" ::: "memory"); // publish the event only after it was written
+    _queueHead = nextHead;
+}
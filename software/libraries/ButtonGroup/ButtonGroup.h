@@ -0,0 +1,60 @@
+#ifndef ButtonGroup_h
+#define ButtonGroup_h
+#include <FastGPIO.h>
+#include "Arduino.h"
+
+/**
+ * @brief A group of latched buttons which share a latch reset pin, read via the port registers.
+ * Pins are mapped to port bit masks at compile time, so reading all buttons takes one PINx read per port the buttons are spread over
+ * (instead of one digitalRead() per button), plus a few bit operations that gather the buttons into a single mask.
+ * The latch reset is pulsed with two direct port writes instead of two digitalWrite() calls.
+ *
+ * Button masks hold one bit per button, bit 0 for the first pin in PINS. Edges between two reads can be found with bit operations,
+ * e.g. `current & ~previous` are the buttons that went HIGH.
+ *
+ * @tparam RESET_PIN Pin used to reset the latches of all buttons of the group.
+ * @tparam PINS [1..8 pins] Pins the buttons are read from, on any of the ports of the ATmega328P.
+ */
+template <uint8_t RESET_PIN, uint8_t... PINS>
+class ButtonGroup
+{
+    static_assert(sizeof...(PINS) >= 1 && sizeof...(PINS) <= 8, "Button masks hold 8 buttons.");
+
+public:
+    static constexpr uint8_t AMOUNT = sizeof...(PINS);
+
+    /**
+     * @brief Configures the button pins as inputs, the reset pin as output and resets the latches.
+     */
+    static void init();
+
+    /**
+     * @brief Reads the levels of all buttons.
+     *
+     * @return uint8_t Button mask of the buttons whose pins are HIGH.
+     */
+    static inline uint8_t read();
+
+    /**
+     * @brief Resets the latches of all buttons of the group, by pulsing the reset pin LOW. Latches of held buttons set again right away,
+     * returns after ~1us so that read() sees them set.
+     */
+    static inline void resetLatches();
+
+    /**
+     * @brief Enables the pin change interrupts of all button pins. Interrupt service routines must be defined for the pin change
+     * groups of the ports the buttons are on (PCINT0_vect for port B, PCINT1_vect for port C, PCINT2_vect for port D).
+     */
+    static void enablePinChangeInterrupts();
+
+private:
+    /**
+     * @brief Returns the mask of all button pins on a port.
+     *
+     * @param port GPIO_PORT_B, GPIO_PORT_C or GPIO_PORT_D.
+     */
+    static constexpr uint8_t portMask(uint8_t port);
+};
+
+#include "ButtonGroup.tpp"
+#endif
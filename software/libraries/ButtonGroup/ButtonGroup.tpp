@@ -0,0 +1,66 @@
+#include "ButtonGroup.h"
+#include "Arduino.h"
+
+template <uint8_t RESET_PIN, uint8_t... PINS>
+constexpr uint8_t ButtonGroup<RESET_PIN, PINS...>::portMask(uint8_t port)
+{
+    return ((gpioPort(PINS) == port ? gpioMask(PINS) : 0) | ...);
+}
+
+template <uint8_t RESET_PIN, uint8_t... PINS>
+void ButtonGroup<RESET_PIN, PINS...>::init()
+{
+    GPIOPort<GPIO_PORT_B>::makeInput(portMask(GPIO_PORT_B));
+    GPIOPort<GPIO_PORT_C>::makeInput(portMask(GPIO_PORT_C));
+    GPIOPort<GPIO_PORT_D>::makeInput(portMask(GPIO_PORT_D));
+
+    GPIOPort<gpioPort(RESET_PIN)>::set(gpioMask(RESET_PIN)); // latch is reset while LOW, so start HIGH
+    GPIOPort<gpioPort(RESET_PIN)>::makeOutput(gpioMask(RESET_PIN));
+    resetLatches(); // discard presses latched before startup
+}
+
+template <uint8_t RESET_PIN, uint8_t... PINS>
+uint8_t ButtonGroup<RESET_PIN, PINS...>::read()
+{
+    // read each port with buttons once, ports without buttons are not read at all
+    uint8_t ports[3] = {0, 0, 0};
+    if constexpr (portMask(GPIO_PORT_B) != 0)
+    {
+        ports[GPIO_PORT_B] = GPIOPort<GPIO_PORT_B>::read();
+    }
+    if constexpr (portMask(GPIO_PORT_C) != 0)
+    {
+        ports[GPIO_PORT_C] = GPIOPort<GPIO_PORT_C>::read();
+    }
+    if constexpr (portMask(GPIO_PORT_D) != 0)
+    {
+        ports[GPIO_PORT_D] = GPIOPort<GPIO_PORT_D>::read();
+    }
+
+    // gather the bits of the pins into a button mask, port and bit of every pin are constants
+    uint8_t buttons = 0;
+    uint8_t button = 1;
+    ((buttons |= (ports[gpioPort(PINS)] & gpioMask(PINS)) ? button : 0, button <<= 1), ...);
+    return buttons;
+}
+
+template <uint8_t RESET_PIN, uint8_t... PINS>
+void ButtonGroup<RESET_PIN, PINS...>::resetLatches()
+{
+    GPIOPort<gpioPort(RESET_PIN)>::clear(gpioMask(RESET_PIN));
+    GPIOPort<gpioPort(RESET_PIN)>::set(gpioMask(RESET_PIN));
+    // Releasing the reset and reading the pins are single instructions, so without a pause the next read() would come before
+    // the latches of held buttons set again and before the pin synchronizer (~1.5 cycles) passes their level on.
+    // Held buttons would then read as released, queueing a false release followed by a new press.
+    delayMicroseconds(1);
+}
+
+template <uint8_t RESET_PIN, uint8_t... PINS>
+void ButtonGroup<RESET_PIN, PINS...>::enablePinChangeInterrupts()
+{
+    // pin change interrupt groups match the ports: group 0 is port B, group 1 is port C, group 2 is port D
+    PCMSK0 |= portMask(GPIO_PORT_B);
+    PCMSK1 |= portMask(GPIO_PORT_C);
+    PCMSK2 |= portMask(GPIO_PORT_D);
+    PCICR |= (portMask(GPIO_PORT_B) ? _BV(GPIO_PORT_B) : 0) | (portMask(GPIO_PORT_C) ? _BV(GPIO_PORT_C) : 0) | (portMask(GPIO_PORT_D) ? _BV(GPIO_PORT_D) : 0);
+}
@@ -36,6 +36,10 @@
 
 #include <util/delay.h>
 
+#if DMX_FAST_READ_ENABLE_PIN >= 0
+#include <FastGPIO.h>
+#endif
+
 
 #if defined (USE_DMX_SERIAL_0)
 
@@ -195,6 +199,19 @@ RDM_Responder   *__rdm_responder;
 
 int8_t          __re_pin;                               // R/W Pin on shield
 
+// Drives the R/W pin on shield
+static inline void writeReadEnable ( uint8_t level )
+{
+#if DMX_FAST_READ_ENABLE_PIN >= 0
+    if ( __re_pin == DMX_FAST_READ_ENABLE_PIN )
+    {
+        FastPin<DMX_FAST_READ_ENABLE_PIN>::write ( level );
+        return;
+    }
+#endif
+    digitalWrite ( __re_pin, level );
+}
+
 isr::isrState   __isr_txState;                          // TX ISR state
 isr::isrState   __isr_rxState;                          // RX ISR state
 
@@ -356,6 +373,19 @@ void DMX_Master::disable ( void )
     __dmx_master = NULL;                                // No active master
 }
 
+void (*DMX_Master::event_onFrameStart)(void);
+
+void DMX_Master::onFrameStart ( void (*func)(void) )
+{
+    event_onFrameStart = func;
+}
+
+void DMX_Master::processFrameStart ( void )
+{
+    if ( event_onFrameStart )
+        event_onFrameStart ();
+}
+
 void    DMX_Master::setAutoBreakMode ( void ) { m_autoBreak = 1; }
 void    DMX_Master::setManualBreakMode ( void ) { m_autoBreak = 0; }
 uint8_t DMX_Master::autoBreakEnabled ( void ) { return m_autoBreak; }
@@ -753,7 +783,7 @@ void RDM_Responder::repondDiscUniqueBranch ( void )
     // Fix: 2017, Feb 28: Moved data enable down in order to limit line in marking state time to comply with
     // section 3.2.3 
     // Set shield to transmit mode (turn arround)
-    digitalWrite ( __re_pin, HIGH );
+    writeReadEnable ( HIGH );
 
 
     for ( int i=0; i<24; i++ )
@@ -1076,7 +1106,7 @@ void SetISRMode ( isr::isrMode mode )
 
     // If read enable pin is assigned
     if (__re_pin > -1)
-        digitalWrite ( __re_pin, readEnable );
+        writeReadEnable ( readEnable );
 
 }
 
@@ -1097,6 +1127,9 @@ ISR (USART_TX)
         
         if ( __isr_txState ==  isr::DmxBreak )
             __isr_txState = isr::DmxStartByte;
+
+        // Break is on the wire, no slots are read until the start byte
+        __dmx_master->processFrameStart ();
         
         break;
 
@@ -76,6 +76,15 @@
 //#define USE_DMX_SERIAL_2
 //#define USE_DMX_SERIAL_3
 
+// Read enable pin that is driven through its port registers, which are
+// resolved at compile time, instead of digitalWrite, so switching the line
+// direction takes a single instruction. Only used while the readEnablePin
+// passed to the constructors is this pin, any other pin is still driven with
+// digitalWrite. Define as -1 in the build flags to always use digitalWrite.
+#ifndef DMX_FAST_READ_ENABLE_PIN
+#define DMX_FAST_READ_ENABLE_PIN    2
+#endif
+
 namespace dmx 
 {
     enum dmxState 
@@ -179,6 +188,14 @@ class DMX_Master
         // Generate break and start transmission of frame
         void breakAndContinue ( uint8_t breakLength_us = 100 );
 
+        // Register on frame start callback, called from the TX ISR
+        // while the break of every auto break frame is transmitted.
+        // Slots may be updated safely from within the callback.
+        void onFrameStart ( void (*func)(void) );
+
+        // Invoke the frame start callback (used by the TX ISR)
+        void processFrameStart ( void );
+
 
     protected:
         void setStartCode ( uint8_t value ); 
@@ -187,6 +204,8 @@ class DMX_Master
     private:
         DMX_FrameBuffer m_frameBuffer;
         uint8_t         m_autoBreak;
+
+        static void (*event_onFrameStart)(void);
 };
 
 
@@ -0,0 +1,119 @@
+#ifndef CooperativeScheduler_h
+#define CooperativeScheduler_h
+#include "Arduino.h"
+
+#define NO_TASK 0xFF
+#define JITTER_BUCKET_AMOUNT 8
+#define JITTER_BUCKET_SHIFT 7
+
+/**
+ * @brief Deadline based cooperative scheduler for up to `TASK_AMOUNT` periodic tasks.
+ * Every task is a plain function that is released once per period. Each call to run() executes at most one released task:
+ * the one with the highest priority, or among equal priorities the one released first. Since tasks are never interrupted,
+ * run() should be called continuously from loop() and tasks should return quickly.
+ *
+ * Releases are absolute deadlines on micros(): every release lies a whole number of periods after start(), no matter how late the task was started.
+ * A late task therefore catches up on its next release instead of shifting all following releases, so its average rate never drifts.
+ * A task overruns when it could not be started before its next release, i.e. it was late by at least one full period.
+ * Missed releases are dropped instead of being caught up on, and counted as overruns of the task.
+ *
+ * For every task, the period jitter (the deviation of the time between two consecutive starts from the period) is recorded in a histogram of
+ * JITTER_BUCKET_AMOUNT logarithmic buckets: bucket 0 counts jitter below 128us, bucket 1 below 256us, ..., bucket 7 everything from 8.192ms upwards.
+ *
+ * @tparam TASK_AMOUNT Maximum amount of tasks that can be added.
+ */
+template <uint8_t TASK_AMOUNT>
+class CooperativeScheduler
+{
+public:
+    /**
+     * @brief Construct a new CooperativeScheduler object without any tasks.
+     */
+    CooperativeScheduler();
+
+    /**
+     * @brief Adds a periodic task. Tasks are not released before start() is called.
+     *
+     * @param function Function to be called once per period.
+     * @param periodMs Period of the task, in ms.
+     * @param priority Priority of the task. If multiple tasks are released, higher values are run first.
+     * @return uint8_t The id of the task, or NO_TASK if TASK_AMOUNT tasks have been added already.
+     */
+    uint8_t addTask(void (*function)(), uint16_t periodMs, uint8_t priority);
+
+    /**
+     * @brief Releases all tasks for the first time and resets their overrun counters.
+     * Should be called once at the end of setup(), so time spent during startup is not counted as overrun.
+     */
+    void start();
+
+    /**
+     * @brief Runs the released task with the highest priority, if there is any.
+     *
+     * @return true if a task was run.
+     * @return false if no task was released.
+     */
+    bool run();
+
+    /**
+     * @brief Enables or disables a task. Disabled tasks are not released. Re-enabled tasks are released immediately and keep their period from then on.
+     * Tasks are enabled when added.
+     *
+     * @param taskId The id of the task, as returned by addTask(...).
+     * @param enabled Whether the task should be released.
+     */
+    void setEnabled(uint8_t taskId, bool enabled);
+
+    /**
+     * @brief Changes the period of a task. The change takes effect after the next release of the task.
+     *
+     * @param taskId The id of the task, as returned by addTask(...).
+     * @param periodMs New period of the task, in ms.
+     */
+    void setPeriod(uint8_t taskId, uint16_t periodMs);
+
+    /**
+     * @brief Returns how late the most recent run of a task was started, relative to its release.
+     * If releases were missed before that run, the lateness is measured from the first missed release, so it can exceed the period.
+     *
+     * @param taskId The id of the task, as returned by addTask(...).
+     * @return uint32_t The lateness in us, not clamped. Callers showing it on a page must clamp it to what the page can display.
+     */
+    uint32_t getLateness(uint8_t taskId);
+
+    /**
+     * @brief Returns the amount of releases a task missed since start() was called. Saturates at 65535.
+     *
+     * @param taskId The id of the task, as returned by addTask(...).
+     * @return uint16_t Amount of overruns.
+     */
+    uint16_t getOverruns(uint8_t taskId);
+
+    /**
+     * @brief Returns a percentile of the period jitter of a task, e.g. 50 for the median or 99 for the jitter that 99% of all periods stay below.
+     * Resolution is limited to the jitter histogram, the upper bound of the bucket containing the percentile is returned.
+     *
+     * @param taskId The id of the task, as returned by addTask(...).
+     * @param percent The percentile to return, 0..100.
+     * @return uint32_t The jitter in us. 0 if the task did not run twice yet, 0xFFFFFFFF if the percentile lies within the last, unbounded bucket.
+     */
+    uint32_t getJitterPercentile(uint8_t taskId, uint8_t percent);
+
+private:
+    uint8_t _taskAmount;
+    void (*_function[TASK_AMOUNT])();
+    uint32_t _periodUs[TASK_AMOUNT];
+    uint8_t _priority[TASK_AMOUNT];
+    uint32_t _releaseTime[TASK_AMOUNT];
+    uint32_t _startTime[TASK_AMOUNT];
+    uint32_t _lateness[TASK_AMOUNT];
+    bool _hasStarted[TASK_AMOUNT];
+    bool _enabled[TASK_AMOUNT];
+    uint16_t _overruns[TASK_AMOUNT];
+    uint8_t _jitterHistogram[TASK_AMOUNT][JITTER_BUCKET_AMOUNT];
+
+    void recordJitter(uint8_t taskId, uint32_t timeNow);
+};
+
+#include "CooperativeScheduler.tpp"
+#endif
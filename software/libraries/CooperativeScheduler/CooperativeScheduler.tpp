@@ -0,0 +1,164 @@
+template <uint8_t TASK_AMOUNT>
+CooperativeScheduler<TASK_AMOUNT>::CooperativeScheduler() : _taskAmount(0)
+{
+}
+
+template <uint8_t TASK_AMOUNT>
+uint8_t CooperativeScheduler<TASK_AMOUNT>::addTask(void (*function)(), uint16_t periodMs, uint8_t priority)
+{
+    if (_taskAmount == TASK_AMOUNT)
+        return NO_TASK;
+
+    _function[_taskAmount] = function;
+    _periodUs[_taskAmount] = max(periodMs, 1) * 1000ul;
+    _priority[_taskAmount] = priority;
+    _releaseTime[_taskAmount] = micros();
+    _lateness[_taskAmount] = 0;
+    _overruns[_taskAmount] = 0;
+    _hasStarted[_taskAmount] = false;
+    _enabled[_taskAmount] = true;
+    for (uint8_t bucket = 0; bucket < JITTER_BUCKET_AMOUNT; bucket++)
+    {
+        _jitterHistogram[_taskAmount][bucket] = 0;
+    }
+    return _taskAmount++;
+}
+
+template <uint8_t TASK_AMOUNT>
+void CooperativeScheduler<TASK_AMOUNT>::start()
+{
+    uint32_t timeNow = micros();
+    for (uint8_t taskId = 0; taskId < _taskAmount; taskId++)
+    {
+        _releaseTime[taskId] = timeNow;
+        _lateness[taskId] = 0;
+        _overruns[taskId] = 0;
+        _hasStarted[taskId] = false;
+        for (uint8_t bucket = 0; bucket < JITTER_BUCKET_AMOUNT; bucket++)
+        {
+            _jitterHistogram[taskId][bucket] = 0;
+        }
+    }
+}
+
+template <uint8_t TASK_AMOUNT>
+bool CooperativeScheduler<TASK_AMOUNT>::run()
+{
+    uint32_t timeNow = micros();
+
+    // find the released task with the highest priority, ties go to the task released first
+    uint8_t nextTask = NO_TASK;
+    for (uint8_t taskId = 0; taskId < _taskAmount; taskId++)
+    {
+        if (!_enabled[taskId] || (int32_t)(timeNow - _releaseTime[taskId]) < 0) // disabled or not released yet
+            continue;
+
+        if (nextTask == NO_TASK || _priority[taskId] > _priority[nextTask] || (_priority[taskId] == _priority[nextTask] && (int32_t)(_releaseTime[taskId] - _releaseTime[nextTask]) < 0))
+        {
+            nextTask = taskId;
+        }
+    }
+
+    if (nextTask == NO_TASK)
+        return false;
+
+    _lateness[nextTask] = timeNow - _releaseTime[nextTask]; // measured before missed releases are dropped, so it includes them
+    // drop releases that were missed entirely and count them as overruns
+    uint32_t missedReleases = (timeNow - _releaseTime[nextTask]) / _periodUs[nextTask];
+    if (missedReleases > 0)
+    {
+        _overruns[nextTask] = min((uint32_t)_overruns[nextTask] + missedReleases, (uint32_t)0xFFFF);
+        _releaseTime[nextTask] += missedReleases * _periodUs[nextTask];
+    }
+
+    recordJitter(nextTask, timeNow);
+    _releaseTime[nextTask] += _periodUs[nextTask]; // next release is relative to this release, not to now, so the task does not drift
+    _function[nextTask]();
+    return true;
+}
+
+template <uint8_t TASK_AMOUNT>
+void CooperativeScheduler<TASK_AMOUNT>::setEnabled(uint8_t taskId, bool enabled)
+{
+    if (enabled && !_enabled[taskId]) // releases missed while disabled are neither overruns nor jitter
+    {
+        _releaseTime[taskId] = micros();
+        _hasStarted[taskId] = false;
+    }
+    _enabled[taskId] = enabled;
+}
+
+template <uint8_t TASK_AMOUNT>
+void CooperativeScheduler<TASK_AMOUNT>::setPeriod(uint8_t taskId, uint16_t periodMs)
+{
+    _periodUs[taskId] = max(periodMs, 1) * 1000ul;
+}
+
+template <uint8_t TASK_AMOUNT>
+uint32_t CooperativeScheduler<TASK_AMOUNT>::getLateness(uint8_t taskId)
+{
+    return _lateness[taskId];
+}
+
+template <uint8_t TASK_AMOUNT>
+uint16_t CooperativeScheduler<TASK_AMOUNT>::getOverruns(uint8_t taskId)
+{
+    return _overruns[taskId];
+}
+
+template <uint8_t TASK_AMOUNT>
+uint32_t CooperativeScheduler<TASK_AMOUNT>::getJitterPercentile(uint8_t taskId, uint8_t percent)
+{
+    uint16_t periods = 0;
+    for (uint8_t bucket = 0; bucket < JITTER_BUCKET_AMOUNT; bucket++)
+    {
+        periods += _jitterHistogram[taskId][bucket];
+    }
+
+    if (periods == 0)
+        return 0;
+
+    uint16_t rank = ((uint32_t)periods * percent + 99) / 100; // amount of periods that must lie within the returned jitter
+    uint16_t periodsBelow = 0;
+    for (uint8_t bucket = 0; bucket < JITTER_BUCKET_AMOUNT - 1; bucket++)
+    {
+        periodsBelow += _jitterHistogram[taskId][bucket];
+        if (periodsBelow >= rank)
+            return (uint32_t)1 << (JITTER_BUCKET_SHIFT + bucket);
+    }
+    return 0xFFFFFFFF;
+}
+
+template <uint8_t TASK_AMOUNT>
+void CooperativeScheduler<TASK_AMOUNT>::recordJitter(uint8_t taskId, uint32_t timeNow)
+{
+    uint32_t previousStartTime = _startTime[taskId];
+    _startTime[taskId] = timeNow;
+    if (!_hasStarted[taskId])
+    {
+        _hasStarted[taskId] = true;
+        return;
+    }
+
+    // deviation of the time since the last start from the period
+    uint32_t interval = timeNow - previousStartTime;
+    uint32_t jitter = (interval > _periodUs[taskId]) ? interval - _periodUs[taskId] : _periodUs[taskId] - interval;
+
+    // find logarithmic bucket, each bucket is twice as wide as the previous one
+    uint8_t bucket = 0;
+    jitter >>= JITTER_BUCKET_SHIFT;
+    while (jitter > 0 && bucket < JITTER_BUCKET_AMOUNT - 1)
+    {
+        jitter >>= 1;
+        bucket++;
+    }
+
+    if (_jitterHistogram[taskId][bucket] == 0xFF) // halve instead of overflowing, keeps the shape of the histogram
+    {
+        for (uint8_t halvedBucket = 0; halvedBucket < JITTER_BUCKET_AMOUNT; halvedBucket++)
+        {
+            _jitterHistogram[taskId][halvedBucket] >>= 1;
+        }
+    }
+    _jitterHistogram[taskId][bucket]++;
+}
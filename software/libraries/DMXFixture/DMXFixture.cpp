@@ -1,73 +1,49 @@
 #include <Conceptinetics.h>
 #include "DMXFixture.h"
 
-DMXFixture::DMXFixture(uint8_t startChannel, uint8_t dimmerDefaultValue) : _startChannel(startChannel), _dimmerDefaultValue(dimmerDefaultValue)
+FixtureProfile FixtureProfile::fromProgmem(const FixtureProfile *profile)
 {
+    return FixtureProfile(pgm_read_dword(&profile->_color), pgm_read_dword(&profile->_frequency));
 }
 
-void DMXFixture::setRGB(uint8_t redValue, uint8_t greenValue, uint8_t blueValue)
-{
-    _redValue = redValue;
-    _greenValue = greenValue;
-    _blueValue = blueValue;
-}
-
-void DMXFixture::setRGBDimmer(uint8_t dimmerValue)
-{
-    _rgbDimmerValue = dimmerValue;
-}
-
-void DMXFixture::setWhite(uint8_t whiteValue)
-{
-    _whiteValue = whiteValue;
-}
-
-void DMXFixture::setDimmer(uint8_t dimmerValue)
-{
-    _dimmerValue = dimmerValue;
-}
-
-void DMXFixture::setStrobe(uint8_t strobeValue)
-{
-    _strobeValue = strobeValue;
-}
-
-void DMXFixture::reset()
-{
-    _dimmerValue = _dimmerDefaultValue;
-    _rgbDimmerValue = 255;
-    _redValue = 0;
-    _greenValue = 0;
-    _blueValue = 0;
-    _whiteValue = 0;
-    _strobeValue = 0;
-}
-
-void DMXFixture::display(DMX_Master &dmxController)
+uint32_t FixtureProfile::getHexColor()
 {
-    dmxController.setChannelValue(_startChannel + localDimmerChannel, _dimmerValue);
-    dmxController.setChannelValue(_startChannel + localRedChannel, (uint8_t) (_redValue * ((float)_rgbDimmerValue / 255.0)));
-    dmxController.setChannelValue(_startChannel + localGreenChannel, (uint8_t) (_greenValue * ((float)_rgbDimmerValue / 255.0)));
-    dmxController.setChannelValue(_startChannel + localBlueChannel, (uint8_t) (_blueValue * ((float)_rgbDimmerValue / 255.0)));
-    dmxController.setChannelValue(_startChannel + localWhiteChannel, _whiteValue);
-    dmxController.setChannelValue(_startChannel + localStrobeChannel, _strobeValue);
+    return _color;
 }
 
-
-FixtureProfile::FixtureProfile(): _color(0x0), _frequency(0x0)
+uint32_t FixtureProfile::getHexFrequency()
 {
+    return _frequency;
 }
 
-FixtureProfile::FixtureProfile(uint32_t color, uint32_t frequency): _color(color), _frequency(frequency)
+BandResponse::BandResponse() : _normalisation(0)
 {
+    for (uint8_t band = 0; band < bandAmount; band++)
+    {
+        _weights[band] = 0;
+    }
 }
 
-uint32_t FixtureProfile::getHexColor()
+BandResponse::BandResponse(uint32_t frequency)
 {
-    return _color;
+    uint8_t observedBands = 0;
+    for (uint8_t band = 0; band < bandAmount; band++)
+    {
+        _weights[band] = (frequency >> (band * 4)) & 0xF; // get response coefficient (is between 0x0 .. 0xF)
+        if (_weights[band] > 0)
+        {
+            observedBands++;
+        }
+    }
+    _normalisation = observedBands ? 65536ul / (15 * observedBands) : 0;
 }
 
-uint32_t FixtureProfile::getHexFrequency()
+uint8_t BandResponse::getBrightness(uint16_t *bandAmplitudes)
 {
-    return _frequency;
+    uint16_t weightedSum = 0; // at most 15 * 255 * 7, fits into 16 bits
+    for (uint8_t band = 0; band < bandAmount; band++)
+    {
+        weightedSum += _weights[band] * bandAmplitudes[band];
+    }
+    return ((uint32_t)weightedSum * _normalisation) >> 16;
 }
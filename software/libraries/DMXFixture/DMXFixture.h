@@ -1,9 +1,10 @@
 #ifndef DMXFixture_h
 #define DMXFixture_h
 #include <Conceptinetics.h>
+#include "FixturePersonality.h"
 
 /**
- * @brief Represents a DMX controlled RGBW light fixture with a channel each reserved for:
+ * @brief Represents a DMX controlled light fixture with buffers for the following attributes:
  * - overall dimmer (0..255)
  * - red light brightness (0..255)
  * - green light brightness (0..255)
@@ -12,29 +13,42 @@
  * - strobe frequency (0..255)
  * Additionally, the red, green, and blue brightness values may be modified concurrently using a virtual rgb-dimmer (this however does not corrospond to an actual DMX channel).
  * Setting any of these values via the implemented public functions will not immediately send these values via DMX to the fixture, for this display(...) must be called first.
- * 
+ * Attributes whose values did not change since the last display(...) are not rewritten, so static fixtures cost next to nothing to display.
+ *
+ * Which of these attributes are sent on which channels is defined by the fixture's personality (see FixturePersonality).
+ * The personality is a template parameter, so display(...) calls the render code generated for it directly, without any lookup at runtime.
+ * Fixtures of different models are therefore of different types; rigs of several models of fixtures use one FixtureBank per model.
+ *
  * DMX channels here are limited to channels 0..255 to save on memory. 
  *
+ * @tparam PERSONALITY The personality describing the channel layout of the fixture model, the 6-channel RGBWStrobePersonality if omitted.
  */
+template <typename PERSONALITY = RGBWStrobePersonality>
 class DMXFixture
 {
 public:
-    static const uint8_t localDimmerChannel = 0;
-    static const uint8_t localRedChannel = 1;
-    static const uint8_t localGreenChannel = 2;
-    static const uint8_t localBlueChannel = 3;
-    static const uint8_t localWhiteChannel = 4;
-    static const uint8_t localStrobeChannel = 5;
-    static const uint8_t channelAmount = 6;
-
     /**
-     * @brief Construct a new DMXFixture object that utilizes 6 channels, starting from the supplied start channel.
+     * @brief Construct a new DMXFixture object, starting from the supplied start channel.
      * 
      * @param startChannel First channel occupied by this DMXFixture.
      * @param dimmerDefaultValue Default value the overall dimmer should assume after reset() is called.
      */
     DMXFixture(uint8_t startChannel, uint8_t dimmerDefaultValue);
 
+    /**
+     * @brief Returns the amount of DMX channels occupied by this fixture, as defined by its personality.
+     *
+     * @return uint8_t Amount of channels, starting from the start channel.
+     */
+    uint8_t getChannelAmount();
+
+    /**
+     * @brief Returns the last DMX channel occupied by this fixture.
+     *
+     * @return uint16_t The start channel plus the amount of channels, minus one.
+     */
+    uint16_t getEndChannel();
+
     /**
      * @brief Sets the internal buffers for the rgb values to the supplied values.
      *
@@ -78,18 +92,24 @@ public:
      * @brief Resets all internal buffers, except for the dimmers, to 0.
      * The overall dimmer is set to the default value supplied initially.
      * The rgb dimmer is set to 255 (100%).
+     * All attributes are rewritten on the next call to display(...).
      * 
      */
     void reset();
 
     /**
      * @brief Takes the values stored in the internal buffers and sends them to the DMX device via the supplied DMX controller.
+     * Only attributes that changed since the last call are written.
+     * Fixtures that do not fit into the DMX controller's buffer are not sent.
      * 
      * @param dmxController DMX_Master that is capable of setting the desired channels.
+     * @return uint8_t Amount of DMX channels whose value changed.
      */
-    void display(DMX_Master &dmxController);
+    uint8_t display(DMX_Master &dmxController);
 
 private:
+    // Mask of ATTRIBUTE_... flags whose values changed since the last display(...)
+    uint8_t _dirtyAttributes;
     uint8_t _startChannel;
     uint8_t _dimmerDefaultValue;
     uint8_t _dimmerValue;
@@ -103,6 +123,8 @@ private:
 
 /**
  * @brief Pair of hex color and frequency response.
+ * FixtureProfiles can be constructed at compile time, so whole profile sets may be declared as `const FixtureProfile NAME[] PROGMEM = {...};`
+ * and kept in flash. Such profiles must be read via FixtureProfile::fromProgmem(...).
  * 
  */
 struct FixtureProfile
@@ -112,7 +134,7 @@ struct FixtureProfile
          * @brief Construct a new Fixture Profile object with 0x0 for both hex color and frequency response.
          * 
          */
-        FixtureProfile();
+        constexpr FixtureProfile() : _color(0x0), _frequency(0x0) {}
 
         /**
          * @brief Construct a new Fixture Profile object with the supplied values.
@@ -121,11 +143,61 @@ struct FixtureProfile
          * @param frequency frequency response. Only the lower 7 half-bytes are used. Each half-byte corrosponds to the response value to a specific frequency band,
          * with the lower bytes corrosponding the the lower frequency bands. 0 represents no response, F maximal response.
          */
-        FixtureProfile(uint32_t color, uint32_t frequency);
+        constexpr FixtureProfile(uint32_t color, uint32_t frequency) : _color(color), _frequency(frequency) {}
+
+        /**
+         * @brief Loads a FixtureProfile that resides in flash memory (PROGMEM) into SRAM.
+         * 
+         * @param profile Address of the profile in flash memory.
+         * @return FixtureProfile A copy of the profile.
+         */
+        static FixtureProfile fromProgmem(const FixtureProfile *profile);
+
         uint32_t getHexColor();
         uint32_t getHexFrequency();
     private:
         uint32_t _color;
         uint32_t _frequency;
 };
+
+/**
+ * @brief Integer form of a FixtureProfile's frequency response, precomputed once whenever the profile assigned to a fixture changes.
+ * Holds the response coefficient of every band and a fixed-point reciprocal of the normalisation divisor,
+ * so that the brightness of a fixture can be computed every frame with a short integer dot product instead of float math.
+ *
+ */
+struct BandResponse
+{
+    public:
+        static const uint8_t bandAmount = 7;
+
+        /**
+         * @brief Construct a new Band Response object which does not respond to any band.
+         * 
+         */
+        BandResponse();
+
+        /**
+         * @brief Construct a new Band Response object from a hex frequency response.
+         * 
+         * @param frequency frequency response as used by FixtureProfile. Only the lower 7 half-bytes are used.
+         */
+        BandResponse(uint32_t frequency);
+
+        /**
+         * @brief Calculates the brightness resulting from the supplied band amplitudes.
+         * This is the average of the amplitudes of all bands this response observes, each scaled by its response coefficient (0x0..0xF = 0%..100%).
+         * The result may be one step lower than the exact average, as the division is replaced by a fixed-point reciprocal.
+         *
+         * @param bandAmplitudes 7 element array of 8-bit band amplitudes (0..255).
+         * @return uint8_t The brightness (0..255). 0 if no band is observed.
+         */
+        uint8_t getBrightness(uint16_t *bandAmplitudes);
+    private:
+        uint8_t _weights[bandAmount];
+        // 65536 / (15 * amount of observed bands), or 0 if no band is observed
+        uint16_t _normalisation;
+};
+
+#include "DMXFixture.tpp"
 #endif
@@ -0,0 +1,104 @@
+template <typename PERSONALITY>
+DMXFixture<PERSONALITY>::DMXFixture(uint8_t startChannel, uint8_t dimmerDefaultValue) : _dirtyAttributes(ATTRIBUTE_ALL), _startChannel(startChannel), _dimmerDefaultValue(dimmerDefaultValue)
+{
+}
+
+template <typename PERSONALITY>
+uint8_t DMXFixture<PERSONALITY>::getChannelAmount()
+{
+    return PERSONALITY::channelAmount;
+}
+
+template <typename PERSONALITY>
+uint16_t DMXFixture<PERSONALITY>::getEndChannel()
+{
+    return (uint16_t)_startChannel + PERSONALITY::channelAmount - 1;
+}
+
+template <typename PERSONALITY>
+void DMXFixture<PERSONALITY>::setRGB(uint8_t redValue, uint8_t greenValue, uint8_t blueValue)
+{
+    if (redValue != _redValue)
+    {
+        _redValue = redValue;
+        _dirtyAttributes |= ATTRIBUTE_RED;
+    }
+    if (greenValue != _greenValue)
+    {
+        _greenValue = greenValue;
+        _dirtyAttributes |= ATTRIBUTE_GREEN;
+    }
+    if (blueValue != _blueValue)
+    {
+        _blueValue = blueValue;
+        _dirtyAttributes |= ATTRIBUTE_BLUE;
+    }
+}
+
+template <typename PERSONALITY>
+void DMXFixture<PERSONALITY>::setRGBDimmer(uint8_t dimmerValue)
+{
+    if (dimmerValue != _rgbDimmerValue)
+    {
+        _rgbDimmerValue = dimmerValue;
+        _dirtyAttributes |= ATTRIBUTE_RED | ATTRIBUTE_GREEN | ATTRIBUTE_BLUE; // rgb dimmer has no channel of its own
+    }
+}
+
+template <typename PERSONALITY>
+void DMXFixture<PERSONALITY>::setWhite(uint8_t whiteValue)
+{
+    if (whiteValue != _whiteValue)
+    {
+        _whiteValue = whiteValue;
+        _dirtyAttributes |= ATTRIBUTE_WHITE;
+    }
+}
+
+template <typename PERSONALITY>
+void DMXFixture<PERSONALITY>::setDimmer(uint8_t dimmerValue)
+{
+    if (dimmerValue != _dimmerValue)
+    {
+        _dimmerValue = dimmerValue;
+        _dirtyAttributes |= ATTRIBUTE_DIMMER;
+    }
+}
+
+template <typename PERSONALITY>
+void DMXFixture<PERSONALITY>::setStrobe(uint8_t strobeValue)
+{
+    if (strobeValue != _strobeValue)
+    {
+        _strobeValue = strobeValue;
+        _dirtyAttributes |= ATTRIBUTE_STROBE;
+    }
+}
+
+template <typename PERSONALITY>
+void DMXFixture<PERSONALITY>::reset()
+{
+    _dimmerValue = _dimmerDefaultValue;
+    _rgbDimmerValue = 255;
+    _redValue = 0;
+    _greenValue = 0;
+    _blueValue = 0;
+    _whiteValue = PERSONALITY::defaultWhite;
+    _strobeValue = PERSONALITY::defaultStrobe;
+    _dirtyAttributes = ATTRIBUTE_ALL;
+}
+
+template <typename PERSONALITY>
+uint8_t DMXFixture<PERSONALITY>::display(DMX_Master &dmxController)
+{
+    if (!_dirtyAttributes)
+        return 0;
+
+    DMX_FrameBuffer &frameBuffer = dmxController.getBuffer();
+    if (_startChannel == 0 || getEndChannel() >= frameBuffer.getBufferSize()) // never overwrite the start code or write past the buffer
+        return 0;
+
+    uint8_t changedChannels = renderFixture<PERSONALITY>(&frameBuffer[_startChannel], _dirtyAttributes, _dimmerValue, _rgbDimmerValue, _redValue, _greenValue, _blueValue, _whiteValue, _strobeValue);
+    _dirtyAttributes = 0;
+    return changedChannels;
+}
@@ -0,0 +1,158 @@
+#ifndef FixtureBank_h
+#define FixtureBank_h
+#include <Conceptinetics.h>
+#include "FixturePersonality.h"
+
+/**
+ * @brief Represents `FIXTURE_AMOUNT` DMX controlled light fixtures of the same model, occupying consecutive DMX channels.
+ * Offers the same attributes as DMXFixture, but stores every attribute as a separate array ("struct of arrays") and renders all
+ * fixtures in a single pass straight into the frame buffer of the DMX controller. The DMX buffer is bounds-checked once per bank
+ * instead of once per channel, so the render cost per fixture is a handful of stores.
+ *
+ * Rigs that mix fixture models use one FixtureBank per model.
+ * Setting any of the values via the implemented public functions will not immediately send these values via DMX to the fixtures, for this display(...) must be called first.
+ * As with DMXFixture, only attributes that changed since the last display(...) are rewritten.
+ *
+ * @tparam PERSONALITY The personality describing the channel layout of the fixture model (see FixturePersonality).
+ * @tparam FIXTURE_AMOUNT Amount of fixtures in this bank.
+ */
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+class FixtureBank
+{
+public:
+    /**
+     * @brief Construct a new FixtureBank object. The first fixture starts at the supplied start channel,
+     * every following fixture starts directly after the last channel of the previous one.
+     *
+     * @param startChannel First channel occupied by the first fixture of this FixtureBank.
+     * @param dimmerDefaultValue Default value the overall dimmers should assume after reset() is called.
+     */
+    FixtureBank(uint8_t startChannel, uint8_t dimmerDefaultValue);
+
+    /**
+     * @brief Sets the internal buffers for the rgb values of a fixture to the supplied values.
+     *
+     * @param fixtureId The index of the fixture within this bank.
+     * @param redValue The red value to write to the internal buffer.
+     * @param greenValue The green value to write to the internal buffer.
+     * @param blueValue The blue value to write to the internal buffer.
+     */
+    void setRGB(uint8_t fixtureId, uint8_t redValue, uint8_t greenValue, uint8_t blueValue);
+
+    /**
+     * @brief Sets the internal buffer for the white value of a fixture to the supplied value.
+     *
+     * @param fixtureId The index of the fixture within this bank.
+     * @param whiteValue The white value to write to the internal buffer.
+     */
+    void setWhite(uint8_t fixtureId, uint8_t whiteValue);
+
+    /**
+     * @brief Sets the internal buffer for the dimmer value of a fixture to the supplied value.
+     *
+     * @param fixtureId The index of the fixture within this bank.
+     * @param dimmerValue The dimmer value to write to the internal buffer.
+     */
+    void setDimmer(uint8_t fixtureId, uint8_t dimmerValue);
+
+    /**
+     * @brief Sets the internal buffer for the rgb dimmer value of a fixture to the supplied value.
+     * The rgb dimmer artificially supresses the rgb values sent to the DMX device.
+     * This does not corrospond to an actual DMX channel.
+     *
+     * @param fixtureId The index of the fixture within this bank.
+     * @param dimmerValue The rgb dimmer value to write to the internal buffer.
+     */
+    void setRGBDimmer(uint8_t fixtureId, uint8_t dimmerValue);
+
+    /**
+     * @brief Sets the internal buffer for the strobe value of a fixture to the supplied value.
+     *
+     * @param fixtureId The index of the fixture within this bank.
+     * @param strobeValue The strobe value to write to the internal buffer.
+     */
+    void setStrobe(uint8_t fixtureId, uint8_t strobeValue);
+
+    /**
+     * @brief Resets the internal buffers of all fixtures, see DMXFixture::reset().
+     */
+    void reset();
+
+    /**
+     * @brief Takes the values stored in the internal buffers of all fixtures and writes them into the frame buffer of the supplied DMX controller.
+     * If the bank does not fit into the DMX controller's buffer, nothing is written.
+     *
+     * @param dmxController DMX_Master that is capable of setting the desired channels.
+     * @return uint16_t Amount of DMX channels whose value changed.
+     */
+    uint16_t display(DMX_Master &dmxController);
+
+    /**
+     * @brief Takes the values stored in the internal buffers of all fixtures and writes them into the supplied frame, e.g. the pending frame of a FrameInterpolator.
+     * Only attributes that changed since the last call are written, so the frame must keep its contents between calls.
+     * If the bank does not fit into the frame, nothing is written.
+     *
+     * @param frame Frame whose indices corrospond to DMX channels.
+     * @param frameSize Size of the frame, including index 0.
+     * @return uint16_t Amount of DMX channels whose value changed.
+     */
+    uint16_t display(uint8_t *frame, uint16_t frameSize);
+
+    /**
+     * @brief Returns the amount of DMX channels whose value changed during the last call to display(...).
+     *
+     * @return uint16_t Amount of changed channels.
+     */
+    uint16_t getChangedChannels();
+
+    /**
+     * @brief Returns the amount of fixtures in this bank.
+     *
+     * @return uint8_t Amount of fixtures.
+     */
+    uint8_t length();
+
+    /**
+     * @brief Returns the first DMX channel occupied by a fixture of this bank.
+     *
+     * @param fixtureId The index of the fixture within this bank.
+     * @return uint16_t The start channel of the fixture.
+     */
+    uint16_t getStartChannel(uint8_t fixtureId);
+
+    /**
+     * @brief Returns the last DMX channel occupied by the last fixture of this bank.
+     *
+     * @return uint16_t The start channel plus the amount of channels of all fixtures, minus one.
+     */
+    uint16_t getEndChannel();
+
+    /**
+     * @brief Returns the last DMX channel occupied by the last fixture of a bank starting at the supplied channel.
+     * Usable in constant expressions, e.g. to size the DMX buffer for a bank.
+     *
+     * @param startChannel First channel occupied by the first fixture of the bank.
+     * @return uint16_t The start channel plus the amount of channels of all fixtures, minus one.
+     */
+    static constexpr uint16_t getEndChannel(uint8_t startChannel)
+    {
+        return (uint16_t)startChannel + (uint16_t)PERSONALITY::channelAmount * FIXTURE_AMOUNT - 1;
+    }
+
+private:
+    uint8_t _startChannel;
+    uint8_t _dimmerDefaultValue;
+    uint8_t _dimmerValue[FIXTURE_AMOUNT];
+    uint8_t _rgbDimmerValue[FIXTURE_AMOUNT];
+    uint8_t _redValue[FIXTURE_AMOUNT];
+    uint8_t _greenValue[FIXTURE_AMOUNT];
+    uint8_t _blueValue[FIXTURE_AMOUNT];
+    uint8_t _whiteValue[FIXTURE_AMOUNT];
+    uint8_t _strobeValue[FIXTURE_AMOUNT];
+    // Masks of ATTRIBUTE_... flags whose values changed since the last display(...)
+    uint8_t _dirtyAttributes[FIXTURE_AMOUNT];
+    uint16_t _changedChannels;
+};
+
+#include "FixtureBank.tpp"
+#endif
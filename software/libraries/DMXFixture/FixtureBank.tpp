@@ -0,0 +1,132 @@
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::FixtureBank(uint8_t startChannel, uint8_t dimmerDefaultValue) : _startChannel(startChannel), _dimmerDefaultValue(dimmerDefaultValue), _changedChannels(0)
+{
+    reset();
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+void FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::setRGB(uint8_t fixtureId, uint8_t redValue, uint8_t greenValue, uint8_t blueValue)
+{
+    if (redValue != _redValue[fixtureId])
+    {
+        _redValue[fixtureId] = redValue;
+        _dirtyAttributes[fixtureId] |= ATTRIBUTE_RED;
+    }
+    if (greenValue != _greenValue[fixtureId])
+    {
+        _greenValue[fixtureId] = greenValue;
+        _dirtyAttributes[fixtureId] |= ATTRIBUTE_GREEN;
+    }
+    if (blueValue != _blueValue[fixtureId])
+    {
+        _blueValue[fixtureId] = blueValue;
+        _dirtyAttributes[fixtureId] |= ATTRIBUTE_BLUE;
+    }
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+void FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::setRGBDimmer(uint8_t fixtureId, uint8_t dimmerValue)
+{
+    if (dimmerValue != _rgbDimmerValue[fixtureId])
+    {
+        _rgbDimmerValue[fixtureId] = dimmerValue;
+        _dirtyAttributes[fixtureId] |= ATTRIBUTE_RED | ATTRIBUTE_GREEN | ATTRIBUTE_BLUE; // rgb dimmer has no channel of its own
+    }
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+void FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::setWhite(uint8_t fixtureId, uint8_t whiteValue)
+{
+    if (whiteValue != _whiteValue[fixtureId])
+    {
+        _whiteValue[fixtureId] = whiteValue;
+        _dirtyAttributes[fixtureId] |= ATTRIBUTE_WHITE;
+    }
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+void FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::setDimmer(uint8_t fixtureId, uint8_t dimmerValue)
+{
+    if (dimmerValue != _dimmerValue[fixtureId])
+    {
+        _dimmerValue[fixtureId] = dimmerValue;
+        _dirtyAttributes[fixtureId] |= ATTRIBUTE_DIMMER;
+    }
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+void FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::setStrobe(uint8_t fixtureId, uint8_t strobeValue)
+{
+    if (strobeValue != _strobeValue[fixtureId])
+    {
+        _strobeValue[fixtureId] = strobeValue;
+        _dirtyAttributes[fixtureId] |= ATTRIBUTE_STROBE;
+    }
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+void FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::reset()
+{
+    for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
+    {
+        _dimmerValue[fixtureId] = _dimmerDefaultValue;
+        _rgbDimmerValue[fixtureId] = 255;
+        _redValue[fixtureId] = 0;
+        _greenValue[fixtureId] = 0;
+        _blueValue[fixtureId] = 0;
+        _whiteValue[fixtureId] = PERSONALITY::defaultWhite;
+        _strobeValue[fixtureId] = PERSONALITY::defaultStrobe;
+        _dirtyAttributes[fixtureId] = ATTRIBUTE_ALL;
+    }
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+uint16_t FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::display(DMX_Master &dmxController)
+{
+    DMX_FrameBuffer &frameBuffer = dmxController.getBuffer();
+    return display(&frameBuffer[0], frameBuffer.getBufferSize());
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+uint16_t FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::display(uint8_t *frame, uint16_t frameSize)
+{
+    _changedChannels = 0;
+    if (_startChannel == 0 || getEndChannel() >= frameSize) // never overwrite the start code or write past the frame
+        return 0;
+
+    uint8_t *slots = &frame[_startChannel];
+    for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
+    {
+        if (_dirtyAttributes[fixtureId])
+        {
+            _changedChannels += renderFixture<PERSONALITY>(slots, _dirtyAttributes[fixtureId], _dimmerValue[fixtureId], _rgbDimmerValue[fixtureId], _redValue[fixtureId], _greenValue[fixtureId], _blueValue[fixtureId], _whiteValue[fixtureId], _strobeValue[fixtureId]);
+            _dirtyAttributes[fixtureId] = 0;
+        }
+        slots += PERSONALITY::channelAmount;
+    }
+    return _changedChannels;
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+uint16_t FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::getChangedChannels()
+{
+    return _changedChannels;
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+uint8_t FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::length()
+{
+    return FIXTURE_AMOUNT;
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+uint16_t FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::getStartChannel(uint8_t fixtureId)
+{
+    return (uint16_t)_startChannel + (uint16_t)PERSONALITY::channelAmount * fixtureId;
+}
+
+template <typename PERSONALITY, uint8_t FIXTURE_AMOUNT>
+uint16_t FixtureBank<PERSONALITY, FIXTURE_AMOUNT>::getEndChannel()
+{
+    return getEndChannel(_startChannel);
+}
@@ -0,0 +1,20 @@
+#include "FixturePersonality.h"
+
+// 65535 * (i * 256 / 65025)^2.2, i.e. gamma 2.2 sampled every 256 steps of the product of two 8-bit values, see gamma16().
+const uint16_t GAMMA_TABLE[256] PROGMEM = {
+    0, 0, 2, 4, 7, 12, 17, 24, 33, 42, 53, 66, 79, 95, 112, 130,
+    150, 171, 194, 218, 244, 272, 301, 332, 365, 399, 435, 473, 512, 553, 596, 641,
+    687, 735, 785, 837, 891, 946, 1003, 1062, 1123, 1186, 1250, 1317, 1385, 1455, 1527, 1601,
+    1677, 1755, 1835, 1916, 2000, 2086, 2173, 2263, 2354, 2448, 2543, 2641, 2740, 2842, 2945, 3051,
+    3158, 3268, 3379, 3493, 3609, 3726, 3846, 3968, 4092, 4218, 4346, 4477, 4609, 4744, 4880, 5019,
+    5160, 5303, 5448, 5595, 5744, 5896, 6050, 6205, 6363, 6524, 6686, 6850, 7017, 7186, 7357, 7530,
+    7706, 7884, 8063, 8246, 8430, 8617, 8805, 8996, 9190, 9385, 9583, 9783, 9985, 10190, 10397, 10606,
+    10817, 11031, 11246, 11465, 11685, 11908, 12133, 12360, 12590, 12822, 13056, 13293, 13532, 13773, 14017, 14262,
+    14511, 14761, 15014, 15269, 15527, 15787, 16049, 16314, 16581, 16850, 17122, 17396, 17673, 17952, 18233, 18517,
+    18803, 19091, 19382, 19675, 19971, 20269, 20570, 20872, 21178, 21486, 21796, 22108, 22423, 22741, 23061, 23383,
+    23708, 24035, 24364, 24697, 25031, 25368, 25708, 26050, 26394, 26741, 27090, 27442, 27796, 28153, 28512, 28874,
+    29238, 29605, 29974, 30346, 30720, 31097, 31476, 31858, 32242, 32629, 33018, 33410, 33804, 34201, 34600, 35002,
+    35407, 35814, 36223, 36635, 37050, 37467, 37887, 38309, 38734, 39161, 39591, 40024, 40459, 40896, 41336, 41779,
+    42224, 42672, 43123, 43576, 44031, 44490, 44951, 45414, 45880, 46349, 46820, 47294, 47770, 48249, 48731, 49215,
+    49702, 50191, 50683, 51178, 51675, 52175, 52678, 53183, 53691, 54201, 54714, 55230, 55748, 56269, 56793, 57319,
+    57848, 58380, 58914, 59451, 59990, 60533, 61078, 61625, 62175, 62728, 63284, 63842, 64403, 64967, 65533, 65535};
@@ -0,0 +1,265 @@
+#ifndef FixturePersonality_h
+#define FixturePersonality_h
+#include "Arduino.h"
+
+#define NO_CHANNEL -1
+
+#define ATTRIBUTE_DIMMER 0x01
+#define ATTRIBUTE_RED 0x02
+#define ATTRIBUTE_GREEN 0x04
+#define ATTRIBUTE_BLUE 0x08
+#define ATTRIBUTE_WHITE 0x10
+#define ATTRIBUTE_STROBE 0x20
+#define ATTRIBUTE_ALL 0x3F
+
+/**
+ * @brief Describes the DMX channel layout ("personality") of a fixture model at compile time.
+ * A personality is declared by deriving from FixturePersonality and overriding the members that differ, e.g.:
+ *
+ *     struct MyBar : FixturePersonality
+ *     {
+ *         static constexpr int8_t redChannel = 0;
+ *         static constexpr int8_t greenChannel = 2;
+ *         static constexpr int8_t blueChannel = 4;
+ *         static constexpr uint8_t fineAttributes = ATTRIBUTE_RED | ATTRIBUTE_GREEN | ATTRIBUTE_BLUE;
+ *         static constexpr uint8_t channelAmount = 6;
+ *     };
+ *
+ * All members are compile-time constants, so renderFixture<MyBar>(...) compiles down to plain stores into the DMX buffer
+ * for exactly the channels the model has.
+ *
+ * - `...Channel` is the offset of the attribute relative to the fixture's start channel, or NO_CHANNEL if the model lacks the attribute.
+ * - `fineAttributes` is a mask of ATTRIBUTE_... flags. Flagged attributes are 16-bit, with the fine channel directly following the coarse channel.
+ * - `gammaAttributes` is a mask of ATTRIBUTE_... flags. Flagged intensities (red, green, blue, white) are gamma corrected, see gamma16().
+ * - `channelAmount` is the total amount of channels occupied by the model.
+ * - `defaultWhite` and `defaultStrobe` are the values these attributes assume after DMXFixture::reset(). Colors always reset to 0,
+ *   the dimmer resets to the default supplied per fixture.
+ *
+ * Models without a dimmer channel have the dimmer folded into their color and white channels.
+ */
+struct FixturePersonality
+{
+    static constexpr int8_t dimmerChannel = NO_CHANNEL;
+    static constexpr int8_t redChannel = NO_CHANNEL;
+    static constexpr int8_t greenChannel = NO_CHANNEL;
+    static constexpr int8_t blueChannel = NO_CHANNEL;
+    static constexpr int8_t whiteChannel = NO_CHANNEL;
+    static constexpr int8_t strobeChannel = NO_CHANNEL;
+    static constexpr uint8_t fineAttributes = 0;
+    static constexpr uint8_t gammaAttributes = ATTRIBUTE_RED | ATTRIBUTE_GREEN | ATTRIBUTE_BLUE;
+    static constexpr uint8_t channelAmount = 0;
+
+    static constexpr uint8_t defaultWhite = 0;
+    static constexpr uint8_t defaultStrobe = 0;
+};
+
+/**
+ * @brief 6-channel RGBW par can: dimmer, red, green, blue, white, strobe.
+ */
+struct RGBWStrobePersonality : FixturePersonality
+{
+    static constexpr int8_t dimmerChannel = 0;
+    static constexpr int8_t redChannel = 1;
+    static constexpr int8_t greenChannel = 2;
+    static constexpr int8_t blueChannel = 3;
+    static constexpr int8_t whiteChannel = 4;
+    static constexpr int8_t strobeChannel = 5;
+    static constexpr uint8_t channelAmount = 6;
+};
+
+/**
+ * @brief 3-channel RGB par can or bar without dimmer: red, green, blue.
+ */
+struct RGBPersonality : FixturePersonality
+{
+    static constexpr int8_t redChannel = 0;
+    static constexpr int8_t greenChannel = 1;
+    static constexpr int8_t blueChannel = 2;
+    static constexpr uint8_t channelAmount = 3;
+};
+
+/**
+ * @brief 8-channel RGB bar with 16-bit color: dimmer, red, red fine, green, green fine, blue, blue fine, strobe.
+ */
+struct RGB16StrobePersonality : FixturePersonality
+{
+    static constexpr int8_t dimmerChannel = 0;
+    static constexpr int8_t redChannel = 1;
+    static constexpr int8_t greenChannel = 3;
+    static constexpr int8_t blueChannel = 5;
+    static constexpr int8_t strobeChannel = 7;
+    static constexpr uint8_t fineAttributes = ATTRIBUTE_RED | ATTRIBUTE_GREEN | ATTRIBUTE_BLUE;
+    static constexpr uint8_t channelAmount = 8;
+};
+
+/**
+ * @brief 2-channel white strobe: dimmer, strobe rate.
+ */
+struct StrobePersonality : FixturePersonality
+{
+    static constexpr int8_t dimmerChannel = 0;
+    static constexpr int8_t strobeChannel = 1;
+    static constexpr uint8_t channelAmount = 2;
+};
+
+/**
+ * @brief Scales an 8-bit value by an 8-bit factor, i.e. computes `value * (scale / 255)` rounded down, using integer arithmetic only.
+ *
+ * @param value The value to be scaled.
+ * @param scale The scaling factor, where 255 corrosponds to 100%.
+ * @return uint8_t The scaled value.
+ */
+inline uint8_t scale8(uint8_t value, uint8_t scale)
+{
+    uint16_t product = (uint16_t)value * scale;
+    return (product + 1 + (product >> 8)) >> 8; // exact product / 255 for all products of two 8-bit values
+}
+
+extern const uint16_t GAMMA_TABLE[256] PROGMEM;
+
+/**
+ * @brief Converts the product of two 8-bit values (e.g. color * dimmer, 0..65025) into a linear 16-bit level (0..65535).
+ *
+ * @param product The product to be converted.
+ * @return uint16_t The 16-bit level, `product * 65535 / 65025` within one step.
+ */
+inline uint16_t linear16(uint16_t product)
+{
+    return product + (product >> 7);
+}
+
+/**
+ * @brief Converts the product of two 8-bit values (e.g. color * dimmer, 0..65025) into a gamma corrected 16-bit level (0..65535).
+ * Perceived brightness of LEDs is far from linear in their PWM duty cycle, so low levels need finer steps than high levels.
+ * The curve is read from GAMMA_TABLE in flash and linearly interpolated between its entries, so low-level fades stay smooth on 16-bit channels.
+ *
+ * @param product The product to be converted.
+ * @return uint16_t The gamma corrected 16-bit level.
+ */
+inline uint16_t gamma16(uint16_t product)
+{
+    uint8_t index = product >> 8;
+    uint16_t lower = pgm_read_word(&GAMMA_TABLE[index]);
+    uint16_t upper = pgm_read_word(&GAMMA_TABLE[index + 1]);
+    return lower + (((uint32_t)(upper - lower) * (product & 0xFF)) >> 8);
+}
+
+/**
+ * @brief Writes a single slot if its value differs from the supplied one.
+ *
+ * @param slot The slot to be written.
+ * @param value The new value of the slot.
+ * @return uint8_t 1 if the slot changed, 0 otherwise.
+ */
+inline uint8_t writeSlot(uint8_t &slot, uint8_t value)
+{
+    if (slot == value)
+        return 0;
+
+    slot = value;
+    return 1;
+}
+
+/**
+ * @brief Writes a single attribute into the slots of a fixture, as coarse 8-bit value or as coarse and fine 16-bit value depending on the personality.
+ * Attributes the personality does not have are discarded at compile time.
+ *
+ * @tparam PERSONALITY The personality of the fixture.
+ * @tparam ATTRIBUTE The ATTRIBUTE_... flag of the attribute to be written.
+ * @tparam CHANNEL The offset of the attribute within the fixture, as declared by the personality.
+ * @param slots Pointer to the DMX slot of the fixture's start channel.
+ * @param level The 16-bit level of the attribute. 8-bit attributes only receive the upper byte.
+ * @return uint8_t Amount of slots whose value changed.
+ */
+template <typename PERSONALITY, uint8_t ATTRIBUTE, int8_t CHANNEL>
+inline uint8_t writeAttribute(uint8_t *slots, uint16_t level)
+{
+    uint8_t changedSlots = 0;
+    if constexpr (CHANNEL != NO_CHANNEL)
+    {
+        changedSlots += writeSlot(slots[CHANNEL], level >> 8);
+        if constexpr (PERSONALITY::fineAttributes & ATTRIBUTE)
+        {
+            changedSlots += writeSlot(slots[CHANNEL + 1], level & 0xFF);
+        }
+    }
+    return changedSlots;
+}
+
+/**
+ * @brief Writes a single intensity attribute into the slots of a fixture, gamma corrected if the personality asks for it.
+ * Attributes the personality does not have are discarded at compile time, including their level calculation.
+ *
+ * @tparam PERSONALITY The personality of the fixture.
+ * @tparam ATTRIBUTE The ATTRIBUTE_... flag of the attribute to be written.
+ * @tparam CHANNEL The offset of the attribute within the fixture, as declared by the personality.
+ * @param slots Pointer to the DMX slot of the fixture's start channel.
+ * @param value The 8-bit value of the attribute.
+ * @param dimmer The 8-bit dimmer to be applied to the value.
+ * @return uint8_t Amount of slots whose value changed.
+ */
+template <typename PERSONALITY, uint8_t ATTRIBUTE, int8_t CHANNEL>
+inline uint8_t writeIntensity(uint8_t *slots, uint8_t value, uint8_t dimmer)
+{
+    if constexpr (CHANNEL != NO_CHANNEL)
+    {
+        uint16_t product = (uint16_t)value * dimmer;
+        if constexpr (PERSONALITY::gammaAttributes & ATTRIBUTE)
+        {
+            return writeAttribute<PERSONALITY, ATTRIBUTE, CHANNEL>(slots, gamma16(product));
+        }
+        else
+        {
+            return writeAttribute<PERSONALITY, ATTRIBUTE, CHANNEL>(slots, linear16(product));
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes the attributes of a fixture into its DMX slots according to its personality.
+ * One instance of this function is generated per personality, containing only the stores that personality needs.
+ * All calculations are done in integer arithmetic.
+ * Only attributes flagged as dirty are calculated and written, all other slots keep their previous value.
+ *
+ * @tparam PERSONALITY The personality of the fixture.
+ * @param slots Pointer to the DMX slot of the fixture's start channel. The caller must ensure PERSONALITY::channelAmount slots are available.
+ * @param dirtyAttributes Mask of ATTRIBUTE_... flags of the attributes whose values changed since the last render.
+ * @param dimmer Overall dimmer value. Folded into color and white if the personality has no dimmer channel.
+ * @param rgbDimmer The rgb dimmer value to be applied to red, green and blue.
+ * @param red Red value.
+ * @param green Green value.
+ * @param blue Blue value.
+ * @param white White value.
+ * @param strobe Strobe value.
+ * @return uint8_t Amount of slots whose value changed.
+ */
+template <typename PERSONALITY>
+uint8_t renderFixture(uint8_t *slots, uint8_t dirtyAttributes, uint8_t dimmer, uint8_t rgbDimmer, uint8_t red, uint8_t green, uint8_t blue, uint8_t white, uint8_t strobe)
+{
+    uint8_t whiteDimmer = 255;
+    if constexpr (PERSONALITY::dimmerChannel == NO_CHANNEL)
+    {
+        rgbDimmer = scale8(rgbDimmer, dimmer);
+        whiteDimmer = dimmer;
+        if (dirtyAttributes & ATTRIBUTE_DIMMER) // the dimmer is folded into the intensities, so these change with it
+            dirtyAttributes |= ATTRIBUTE_RED | ATTRIBUTE_GREEN | ATTRIBUTE_BLUE | ATTRIBUTE_WHITE;
+    }
+
+    uint8_t changedSlots = 0;
+    if (dirtyAttributes & ATTRIBUTE_DIMMER)
+        changedSlots += writeAttribute<PERSONALITY, ATTRIBUTE_DIMMER, PERSONALITY::dimmerChannel>(slots, (uint16_t)dimmer * 257); // value * 257 == (value << 8) | value, unsigned as it overflows a 16-bit int
+    if (dirtyAttributes & ATTRIBUTE_RED)
+        changedSlots += writeIntensity<PERSONALITY, ATTRIBUTE_RED, PERSONALITY::redChannel>(slots, red, rgbDimmer);
+    if (dirtyAttributes & ATTRIBUTE_GREEN)
+        changedSlots += writeIntensity<PERSONALITY, ATTRIBUTE_GREEN, PERSONALITY::greenChannel>(slots, green, rgbDimmer);
+    if (dirtyAttributes & ATTRIBUTE_BLUE)
+        changedSlots += writeIntensity<PERSONALITY, ATTRIBUTE_BLUE, PERSONALITY::blueChannel>(slots, blue, rgbDimmer);
+    if (dirtyAttributes & ATTRIBUTE_WHITE)
+        changedSlots += writeIntensity<PERSONALITY, ATTRIBUTE_WHITE, PERSONALITY::whiteChannel>(slots, white, whiteDimmer);
+    if (dirtyAttributes & ATTRIBUTE_STROBE)
+        changedSlots += writeAttribute<PERSONALITY, ATTRIBUTE_STROBE, PERSONALITY::strobeChannel>(slots, (uint16_t)strobe * 257);
+    return changedSlots;
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef FrameInterpolator_h
+#define FrameInterpolator_h
+#include <Conceptinetics.h>
+
+/**
+ * @brief Smooths the transition between two rendered light frames over multiple transmitted DMX frames.
+ * The lights are rendered less often than DMX frames are sent (e.g. every 66ms vs. every ~23ms), which would otherwise hold every value
+ * for several DMX frames and make fades look steppy. Instead, rendering writes into a pending frame, and commit() makes this the new target.
+ * tick() is called once per transmitted DMX frame (see DMX_Master::onFrameStart) and writes a linear blend between the previously
+ * transmitted values and the target into the DMX frame buffer, reaching the target after `stepsPerFrame` DMX frames.
+ *
+ * Channels whose values do not describe a continuous intensity (e.g. strobe or mode channels, or the fine channels of 16-bit attributes)
+ * should be excluded from blending via snapChannel().
+ *
+ * @tparam CHANNELS Highest DMX channel to be interpolated. Channels 1..CHANNELS are managed by the interpolator.
+ */
+template <uint16_t CHANNELS>
+class FrameInterpolator
+{
+public:
+    /**
+     * @brief Construct a new FrameInterpolator object.
+     *
+     * @param dmxController DMX_Master whose frame buffer the interpolated values are written to.
+     * @param stepsPerFrame Amount of DMX frames over which a transition between two committed frames is spread.
+     */
+    FrameInterpolator(DMX_Master &dmxController, uint8_t stepsPerFrame);
+
+    /**
+     * @brief Returns the frame that is to be rendered into. Indices corrospond to DMX channels, index 0 is unused.
+     * Changes to this frame only take effect once commit() is called.
+     *
+     * @return uint8_t* Pointer to the pending frame, which has a size of `CHANNELS + 1`.
+     */
+    uint8_t *getPendingFrame();
+
+    /**
+     * @brief Makes the pending frame the new target. The transition starts from the values currently being transmitted.
+     */
+    void commit();
+
+    /**
+     * @brief Excludes a channel from blending. The channel jumps straight to its target value on the next DMX frame.
+     *
+     * @param channel The DMX channel (1..CHANNELS) to be excluded.
+     */
+    void snapChannel(uint16_t channel);
+
+    /**
+     * @brief Advances the transition by one DMX frame and writes the blended values into the DMX frame buffer.
+     * Designed to be called from DMX_Master's frame start callback, i.e. from within the TX ISR.
+     */
+    void tick();
+
+private:
+    DMX_Master &_dmxController;
+    uint8_t _stepsPerFrame;
+    uint8_t _step;
+    uint8_t _pending[CHANNELS + 1];
+    uint8_t _previous[CHANNELS + 1];
+    uint8_t _target[CHANNELS + 1];
+    uint8_t _snapMask[CHANNELS / 8 + 1];
+};
+
+#include "FrameInterpolator.tpp"
+#endif
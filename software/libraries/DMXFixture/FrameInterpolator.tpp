@@ -0,0 +1,72 @@
+template <uint16_t CHANNELS>
+FrameInterpolator<CHANNELS>::FrameInterpolator(DMX_Master &dmxController, uint8_t stepsPerFrame) : _dmxController(dmxController), _stepsPerFrame(max(stepsPerFrame, 1)), _step(0)
+{
+    for (uint16_t channel = 0; channel <= CHANNELS; channel++)
+    {
+        _pending[channel] = 0;
+        _previous[channel] = 0;
+        _target[channel] = 0;
+    }
+
+    for (uint8_t maskByte = 0; maskByte < CHANNELS / 8 + 1; maskByte++)
+    {
+        _snapMask[maskByte] = 0;
+    }
+}
+
+template <uint16_t CHANNELS>
+uint8_t *FrameInterpolator<CHANNELS>::getPendingFrame()
+{
+    return _pending;
+}
+
+template <uint16_t CHANNELS>
+void FrameInterpolator<CHANNELS>::commit()
+{
+    DMX_FrameBuffer &frameBuffer = _dmxController.getBuffer();
+
+    // the TX ISR must not blend while previous and target are being swapped
+    noInterrupts();
+    for (uint16_t channel = 1; channel <= CHANNELS; channel++)
+    {
+        _previous[channel] = frameBuffer.getSlotValue(channel); // start transition from what is currently transmitted
+        _target[channel] = _pending[channel];
+    }
+    _step = 0;
+    interrupts();
+}
+
+template <uint16_t CHANNELS>
+void FrameInterpolator<CHANNELS>::snapChannel(uint16_t channel)
+{
+    if (channel > CHANNELS)
+        return;
+
+    _snapMask[channel / 8] |= (1 << (channel % 8));
+}
+
+template <uint16_t CHANNELS>
+void FrameInterpolator<CHANNELS>::tick()
+{
+    DMX_FrameBuffer &frameBuffer = _dmxController.getBuffer();
+    if (CHANNELS >= frameBuffer.getBufferSize()) // never write past the buffer
+        return;
+
+    if (_step == _stepsPerFrame) // target was reached and written on a previous frame already
+        return;
+
+    _step++;
+    uint8_t weight = ((uint16_t)_step << 7) / _stepsPerFrame; // blend weight of the target, 128 == 100%. Keeps difference * weight within 16 bits
+
+    for (uint16_t channel = 1; channel <= CHANNELS; channel++)
+    {
+        if (_snapMask[channel / 8] & (1 << (channel % 8)))
+        {
+            frameBuffer[channel] = _target[channel];
+            continue;
+        }
+
+        int16_t difference = (int16_t)_target[channel] - _previous[channel];
+        frameBuffer[channel] = _previous[channel] + ((difference * weight) >> 7);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef ProfileRotation_h
+#define ProfileRotation_h
+#include "Arduino.h"
+#include "DMXFixture.h"
+
+#define NO_PROFILE_GROUP 0xFF // marks that no profile group has been assigned yet, forcing the first update() to assign one
+
+/**
+ * @brief Assigns the profiles of one profile group to `FIXTURE_AMOUNT` fixtures and rotates this assignment periodically.
+ * Rotating moves every fixture on to the next profile of the group, which equally utilizes LEDs over all fixtures, preventing "burn in".
+ *
+ * The assignment is kept as an index table (fixture -> profile slot) together with a copy of each assigned profile and its BandResponse.
+ * Both are only recomputed when the rotation period has passed or a different profile group is requested,
+ * so reading the assigned profiles every frame costs no more than an array access, independent of rig size.
+ * The profile groups stay in flash memory, only the profiles assigned to fixtures are copied to SRAM.
+ * If there are more fixtures than profiles per group, profiles are assigned to multiple fixtures.
+ *
+ * @tparam FIXTURE_AMOUNT Amount of fixtures profiles are assigned to.
+ */
+template <uint8_t FIXTURE_AMOUNT>
+class ProfileRotation
+{
+public:
+    /**
+     * @brief Construct a new ProfileRotation object. No profiles are assigned until update() is called for the first time.
+     *
+     * @param profileGroups Array of profile groups. Each profile group is an array of `profileAmount` profiles.
+     * The array of profile groups as well as the profile groups themselves must reside in flash memory (PROGMEM).
+     * @param profileAmount Amount of profiles in each profile group.
+     * @param rotationPeriodMs Amount of milliseconds until the assignment of profiles to fixtures is rotated.
+     */
+    ProfileRotation(const FixtureProfile *const *profileGroups, uint8_t profileAmount, uint16_t rotationPeriodMs);
+
+    /**
+     * @brief Rotates the assignment if the rotation period has passed, and reassigns all profiles if a different profile group is requested.
+     * Returns immediately otherwise. Call this once per frame.
+     *
+     * @param profileGroup Index of the profile group to be assigned to the fixtures.
+     * @param rotate Whether the assignment may be rotated. If false, a due rotation is postponed until the next call that allows it,
+     * while a different profile group is still assigned right away.
+     * @return true If the assigned profiles changed.
+     * @return false If the assigned profiles are the same as before.
+     */
+    bool update(uint8_t profileGroup, bool rotate = true);
+
+    /**
+     * @brief Returns the profile currently assigned to a fixture.
+     *
+     * @param fixtureId The index of the fixture.
+     * @return FixtureProfile& The profile assigned to the fixture.
+     */
+    FixtureProfile &getProfile(uint8_t fixtureId);
+
+    /**
+     * @brief Returns the precomputed band response of the profile currently assigned to a fixture.
+     *
+     * @param fixtureId The index of the fixture.
+     * @return BandResponse& The band response of the profile assigned to the fixture.
+     */
+    BandResponse &getBandResponse(uint8_t fixtureId);
+
+    /**
+     * @brief Returns the slot within the active profile group of the profile currently assigned to a fixture.
+     *
+     * @param fixtureId The index of the fixture.
+     * @return uint8_t Index of the profile within its profile group.
+     */
+    uint8_t getProfileIndex(uint8_t fixtureId);
+
+private:
+    const FixtureProfile *const *_profileGroups;
+    uint8_t _profileAmount;
+    uint16_t _rotationPeriodMs;
+    uint32_t _rotationTimestamp;
+    uint8_t _profileGroup;
+    uint8_t _profileIndex[FIXTURE_AMOUNT];
+    FixtureProfile _profiles[FIXTURE_AMOUNT];
+    BandResponse _bandResponses[FIXTURE_AMOUNT];
+};
+
+#include "ProfileRotation.tpp"
+#endif
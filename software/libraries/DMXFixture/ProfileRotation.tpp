@@ -0,0 +1,57 @@
+template <uint8_t FIXTURE_AMOUNT>
+ProfileRotation<FIXTURE_AMOUNT>::ProfileRotation(const FixtureProfile *const *profileGroups, uint8_t profileAmount, uint16_t rotationPeriodMs) : _profileGroups(profileGroups), _profileAmount(profileAmount), _rotationPeriodMs(rotationPeriodMs), _rotationTimestamp(0), _profileGroup(NO_PROFILE_GROUP)
+{
+    for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
+    {
+        _profileIndex[fixtureId] = fixtureId % profileAmount; // initial assignment: fixture n gets profile n
+    }
+}
+
+template <uint8_t FIXTURE_AMOUNT>
+bool ProfileRotation<FIXTURE_AMOUNT>::update(uint8_t profileGroup, bool rotate)
+{
+    bool changed = (profileGroup != _profileGroup);
+
+    // rotate index table by one profile if the rotation period has passed
+    uint32_t timeNow = millis();
+    if (rotate && timeNow - _rotationTimestamp >= _rotationPeriodMs)
+    {
+        for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
+        {
+            _profileIndex[fixtureId] = (_profileIndex[fixtureId] + 1 == _profileAmount) ? 0 : _profileIndex[fixtureId] + 1;
+        }
+        _rotationTimestamp = timeNow;
+        changed = true;
+    }
+
+    if (!changed)
+        return false;
+
+    // reload assigned profiles from the requested profile group
+    _profileGroup = profileGroup;
+    const FixtureProfile *group = (const FixtureProfile *)pgm_read_ptr(&_profileGroups[profileGroup]);
+    for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
+    {
+        _profiles[fixtureId] = FixtureProfile::fromProgmem(&group[_profileIndex[fixtureId]]);
+        _bandResponses[fixtureId] = BandResponse(_profiles[fixtureId].getHexFrequency());
+    }
+    return true;
+}
+
+template <uint8_t FIXTURE_AMOUNT>
+FixtureProfile &ProfileRotation<FIXTURE_AMOUNT>::getProfile(uint8_t fixtureId)
+{
+    return _profiles[fixtureId];
+}
+
+template <uint8_t FIXTURE_AMOUNT>
+BandResponse &ProfileRotation<FIXTURE_AMOUNT>::getBandResponse(uint8_t fixtureId)
+{
+    return _bandResponses[fixtureId];
+}
+
+template <uint8_t FIXTURE_AMOUNT>
+uint8_t ProfileRotation<FIXTURE_AMOUNT>::getProfileIndex(uint8_t fixtureId)
+{
+    return _profileIndex[fixtureId];
+}
@@ -0,0 +1,130 @@
+#ifndef DecimatingHistory_h
+#define DecimatingHistory_h
+#include "Arduino.h"
+
+/**
+ * @brief DecimatingHistory is a cascade of discarding queues ("levels") that keeps a long-horizon history of `TYPE` numbers in little memory.
+ * Level 0 stores the latest `LENGTH` values at full rate. Every `DECIMATION` values that enter a level are pre-aggregated into a single
+ * min/max/mean entry which is then pushed into the next level. Level `n` therefore covers `LENGTH * DECIMATION^n` updates.
+ * E.g. `DecimatingHistory<uint16_t, 32, 3, 8>` covers 32, 256 and 2048 frames, which at 66ms per frame equals roughly 2s, 17s and 135s.
+ * Every entry takes three `TYPE` values, so this example takes 609 bytes of SRAM on the ATmega328P, whereas `DecimatingHistory<uint8_t, 16, 3, 8>`
+ * covers 1s, 8s and 67s in 173 bytes. Entries start out as 0, so the minimum of a level is 0 until the level was filled once.
+ *
+ * Updating the history touches at most one entry per level and is therefore independent of the history length.
+ * The mean of a level is kept as a running sum, so querying it is independent of the history length as well.
+ *
+ * @tparam TYPE Numeric type of the stored values. Must be an unsigned integer type of at most 16 bits.
+ * @tparam LENGTH Amount of entries kept per level.
+ * @tparam LEVELS [2..] Amount of levels. Each level adds `LENGTH` entries of min/max/mean. Use NumericHistory for a single level.
+ * @tparam DECIMATION Amount of entries of one level that are aggregated into a single entry of the next level.
+ */
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+class DecimatingHistory
+{
+    static_assert(LEVELS >= 2, "A single level does not decimate, use NumericHistory instead");
+
+public:
+    /**
+     * @brief Construct a new DecimatingHistory object with all entries set to 0.
+     */
+    DecimatingHistory();
+
+    /**
+     * @brief Adds a new value to level 0 of the history. If this completes a block of `DECIMATION` values on a level,
+     * the aggregate of that block is pushed into the next level.
+     *
+     * @param value The value to be written to the history.
+     */
+    void update(TYPE value);
+
+    /**
+     * @brief Returns the mean of a single entry of a level.
+     *
+     * @param level The level to be read from. Level 0 holds the full-rate values.
+     * @param index The index of the entry, relative to the latest entry of that level. `index=0` yields the latest entry.
+     * @return TYPE The mean of all values aggregated into this entry.
+     */
+    TYPE getMean(uint8_t level, uint8_t index);
+
+    /**
+     * @brief Returns the minimum of a single entry of a level.
+     *
+     * @param level The level to be read from. Level 0 holds the full-rate values.
+     * @param index The index of the entry, relative to the latest entry of that level. `index=0` yields the latest entry.
+     * @return TYPE The minimum of all values aggregated into this entry.
+     */
+    TYPE getMin(uint8_t level, uint8_t index);
+
+    /**
+     * @brief Returns the maximum of a single entry of a level.
+     *
+     * @param level The level to be read from. Level 0 holds the full-rate values.
+     * @param index The index of the entry, relative to the latest entry of that level. `index=0` yields the latest entry.
+     * @return TYPE The maximum of all values aggregated into this entry.
+     */
+    TYPE getMax(uint8_t level, uint8_t index);
+
+    /**
+     * @brief Returns the mean over all entries of a level. This is read from a running sum and does not iterate the level.
+     *
+     * @param level The level to be averaged.
+     * @return TYPE The mean over the full time span covered by the level.
+     */
+    TYPE getLevelMean(uint8_t level);
+
+    /**
+     * @brief Returns the minimum over all entries of a level.
+     *
+     * @param level The level to be searched.
+     * @return TYPE The minimum over the full time span covered by the level.
+     */
+    TYPE getLevelMin(uint8_t level);
+
+    /**
+     * @brief Returns the maximum over all entries of a level.
+     *
+     * @param level The level to be searched.
+     * @return TYPE The maximum over the full time span covered by the level.
+     */
+    TYPE getLevelMax(uint8_t level);
+
+    /**
+     * @brief Returns the amount of entries per level.
+     *
+     * @return uint8_t Amount of entries kept on every level.
+     */
+    uint8_t length();
+
+    /**
+     * @brief Returns the amount of levels.
+     *
+     * @return uint8_t Amount of levels held by this instance of DecimatingHistory.
+     */
+    uint8_t levels();
+
+private:
+    TYPE _min[LEVELS][LENGTH];
+    TYPE _max[LEVELS][LENGTH];
+    TYPE _mean[LEVELS][LENGTH];
+    uint32_t _levelSum[LEVELS];
+    uint8_t _latestEntry[LEVELS];
+
+    // Aggregate of the block that is currently being collected for the next level. There is no block above the last level.
+    TYPE _blockMin[LEVELS - 1];
+    TYPE _blockMax[LEVELS - 1];
+    uint32_t _blockSum[LEVELS - 1];
+    uint8_t _blockFill[LEVELS - 1];
+
+    /**
+     * @brief Pushes an aggregated entry into a level and forwards completed blocks to the next level.
+     *
+     * @param level The level to be written to.
+     * @param min The minimum of the aggregated entry.
+     * @param max The maximum of the aggregated entry.
+     * @param mean The mean of the aggregated entry.
+     */
+    void push(uint8_t level, TYPE min, TYPE max, TYPE mean);
+};
+
+#include "DecimatingHistory.tpp"
+#endif
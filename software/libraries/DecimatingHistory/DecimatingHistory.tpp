@@ -0,0 +1,123 @@
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::DecimatingHistory()
+{
+    for (uint8_t level = 0; level < LEVELS; level++)
+    {
+        for (uint8_t index = 0; index < LENGTH; index++)
+        {
+            _min[level][index] = 0;
+            _max[level][index] = 0;
+            _mean[level][index] = 0;
+        }
+        _levelSum[level] = 0;
+        _latestEntry[level] = LENGTH - 1;
+    }
+
+    for (uint8_t level = 0; level < LEVELS - 1; level++)
+    {
+        _blockFill[level] = 0;
+    }
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+void DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::update(TYPE value)
+{
+    push(0, value, value, value);
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+void DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::push(uint8_t level, TYPE min, TYPE max, TYPE mean)
+{
+    while (true)
+    {
+        // replace oldest entry of this level and keep the running sum in sync
+        uint8_t entry = (_latestEntry[level] + 1) % LENGTH;
+        _levelSum[level] += (uint32_t)mean - _mean[level][entry];
+        _min[level][entry] = min;
+        _max[level][entry] = max;
+        _mean[level][entry] = mean;
+        _latestEntry[level] = entry;
+
+        if (level == LEVELS - 1) // the last level does not feed a block
+            return;
+
+        // add entry to the block collected for the next level
+        if (_blockFill[level] == 0)
+        {
+            _blockMin[level] = min;
+            _blockMax[level] = max;
+            _blockSum[level] = 0;
+        }
+        _blockMin[level] = (min < _blockMin[level]) ? min : _blockMin[level];
+        _blockMax[level] = (max > _blockMax[level]) ? max : _blockMax[level];
+        _blockSum[level] += mean;
+
+        if (++_blockFill[level] < DECIMATION) // block is not complete yet, no need to touch the next level
+            return;
+
+        // block is complete, forward its aggregate to the next level
+        _blockFill[level] = 0;
+        min = _blockMin[level];
+        max = _blockMax[level];
+        mean = _blockSum[level] / DECIMATION;
+        level++;
+    }
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+TYPE DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::getMean(uint8_t level, uint8_t index)
+{
+    return _mean[level][(_latestEntry[level] + LENGTH - index) % LENGTH];
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+TYPE DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::getMin(uint8_t level, uint8_t index)
+{
+    return _min[level][(_latestEntry[level] + LENGTH - index) % LENGTH];
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+TYPE DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::getMax(uint8_t level, uint8_t index)
+{
+    return _max[level][(_latestEntry[level] + LENGTH - index) % LENGTH];
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+TYPE DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::getLevelMean(uint8_t level)
+{
+    return _levelSum[level] / LENGTH;
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+TYPE DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::getLevelMin(uint8_t level)
+{
+    TYPE levelMin = _min[level][0];
+    for (uint8_t index = 1; index < LENGTH; index++)
+    {
+        levelMin = (_min[level][index] < levelMin) ? _min[level][index] : levelMin;
+    }
+    return levelMin;
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+TYPE DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::getLevelMax(uint8_t level)
+{
+    TYPE levelMax = _max[level][0];
+    for (uint8_t index = 1; index < LENGTH; index++)
+    {
+        levelMax = (_max[level][index] > levelMax) ? _max[level][index] : levelMax;
+    }
+    return levelMax;
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+uint8_t DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::length()
+{
+    return LENGTH;
+}
+
+template <typename TYPE, uint8_t LENGTH, uint8_t LEVELS, uint8_t DECIMATION>
+uint8_t DecimatingHistory<TYPE, LENGTH, LEVELS, DECIMATION>::levels()
+{
+    return LEVELS;
+}
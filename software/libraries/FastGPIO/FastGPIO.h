@@ -0,0 +1,128 @@
+#ifndef FastGPIO_h
+#define FastGPIO_h
+#include "Arduino.h"
+
+// ports of the ATmega328P (Arduino Uno, Nano, Pro Mini), which are also its pin change interrupt groups: B is group 0, C is group 1, D is group 2
+#define GPIO_PORT_B 0
+#define GPIO_PORT_C 1
+#define GPIO_PORT_D 2
+
+/**
+ * @brief Returns the port of an Arduino pin of the ATmega328P: pins 0..7 are on port D, pins 8..13 on port B and pins 14..19 (A0..A5) on port C.
+ * Resolves at compile time if the pin is a constant, unlike digitalPinToPort(), which reads a table in flash memory.
+ *
+ * @param pin [0..19] The pin.
+ * @return constexpr uint8_t GPIO_PORT_B, GPIO_PORT_C or GPIO_PORT_D.
+ */
+constexpr uint8_t gpioPort(uint8_t pin)
+{
+    return (pin <= 7) ? GPIO_PORT_D : ((pin <= 13) ? GPIO_PORT_B : GPIO_PORT_C);
+}
+
+/**
+ * @brief Returns the bit of an Arduino pin of the ATmega328P within its port, see gpioPort().
+ *
+ * @param pin [0..19] The pin.
+ * @return constexpr uint8_t Mask with only the bit of the pin set.
+ */
+constexpr uint8_t gpioMask(uint8_t pin)
+{
+    return 1 << ((pin <= 7) ? pin : ((pin <= 13) ? pin - 8 : pin - 14));
+}
+
+/**
+ * @brief Direct access to the registers of a port. The registers are chosen at compile time, so every access is a single instruction
+ * (`in`/`out`, or `sbi`/`cbi` when setting or clearing a single constant bit), instead of the pin lookups digitalRead() and digitalWrite() do.
+ * Setting and clearing bits is only atomic if the mask is a constant with a single bit set; otherwise interrupts that write
+ * the same port must be disabled.
+ *
+ * @tparam PORT GPIO_PORT_B, GPIO_PORT_C or GPIO_PORT_D.
+ */
+template <uint8_t PORT>
+struct GPIOPort
+{
+    /**
+     * @brief Reads the levels of all pins of the port (PINx).
+     *
+     * @return uint8_t One bit per pin, set if the pin is HIGH.
+     */
+    static inline uint8_t read();
+
+    /**
+     * @brief Drives output pins HIGH, respectively enables the pull-up resistors of input pins (PORTx).
+     *
+     * @param mask Pins to be changed.
+     */
+    static inline void set(uint8_t mask);
+
+    /**
+     * @brief Drives output pins LOW, respectively disables the pull-up resistors of input pins (PORTx).
+     *
+     * @param mask Pins to be changed.
+     */
+    static inline void clear(uint8_t mask);
+
+    /**
+     * @brief Configures pins as outputs (DDRx).
+     *
+     * @param mask Pins to be changed.
+     */
+    static inline void makeOutput(uint8_t mask);
+
+    /**
+     * @brief Configures pins as inputs without pull-up resistors, like pinMode(pin, INPUT) does.
+     *
+     * @param mask Pins to be changed.
+     */
+    static inline void makeInput(uint8_t mask);
+};
+
+/**
+ * @brief A single pin whose port and bit are resolved at compile time. Setting and clearing it compiles to a single `sbi`/`cbi`,
+ * which takes 2 cycles and is atomic, so the pin may also be written from interrupts. digitalWrite() takes ~60 cycles for the same,
+ * as it looks up port and bit in flash memory and checks whether the pin has a timer attached.
+ *
+ * @tparam PIN [0..19] The Arduino pin.
+ */
+template <uint8_t PIN>
+struct FastPin
+{
+    static_assert(PIN <= 19, "FastPin only covers the pins of the ATmega328P");
+
+    /**
+     * @brief Drives the pin HIGH, respectively enables its pull-up resistor if it is an input.
+     */
+    static inline void set();
+
+    /**
+     * @brief Drives the pin LOW, respectively disables its pull-up resistor if it is an input.
+     */
+    static inline void clear();
+
+    /**
+     * @brief Drives the pin to a level, like digitalWrite() does.
+     *
+     * @param level HIGH or LOW.
+     */
+    static inline void write(uint8_t level);
+
+    /**
+     * @brief Reads the level of the pin, like digitalRead() does.
+     *
+     * @return uint8_t HIGH or LOW.
+     */
+    static inline uint8_t read();
+
+    /**
+     * @brief Configures the pin as output, like pinMode(PIN, OUTPUT) does.
+     */
+    static inline void makeOutput();
+
+    /**
+     * @brief Configures the pin as input without pull-up resistor, like pinMode(PIN, INPUT) does.
+     */
+    static inline void makeInput();
+};
+
+#include "FastGPIO.tpp"
+#endif
@@ -0,0 +1,131 @@
+#include "FastGPIO.h"
+#include "Arduino.h"
+
+template <uint8_t PORT>
+uint8_t GPIOPort<PORT>::read()
+{
+    if constexpr (PORT == GPIO_PORT_B)
+    {
+        return PINB;
+    }
+    else if constexpr (PORT == GPIO_PORT_C)
+    {
+        return PINC;
+    }
+    else
+    {
+        return PIND;
+    }
+}
+
+template <uint8_t PORT>
+void GPIOPort<PORT>::set(uint8_t mask)
+{
+    if constexpr (PORT == GPIO_PORT_B)
+    {
+        PORTB |= mask;
+    }
+    else if constexpr (PORT == GPIO_PORT_C)
+    {
+        PORTC |= mask;
+    }
+    else
+    {
+        PORTD |= mask;
+    }
+}
+
+template <uint8_t PORT>
+void GPIOPort<PORT>::clear(uint8_t mask)
+{
+    if constexpr (PORT == GPIO_PORT_B)
+    {
+        PORTB &= ~mask;
+    }
+    else if constexpr (PORT == GPIO_PORT_C)
+    {
+        PORTC &= ~mask;
+    }
+    else
+    {
+        PORTD &= ~mask;
+    }
+}
+
+template <uint8_t PORT>
+void GPIOPort<PORT>::makeOutput(uint8_t mask)
+{
+    if constexpr (PORT == GPIO_PORT_B)
+    {
+        DDRB |= mask;
+    }
+    else if constexpr (PORT == GPIO_PORT_C)
+    {
+        DDRC |= mask;
+    }
+    else
+    {
+        DDRD |= mask;
+    }
+}
+
+template <uint8_t PORT>
+void GPIOPort<PORT>::makeInput(uint8_t mask)
+{
+    if constexpr (PORT == GPIO_PORT_B)
+    {
+        DDRB &= ~mask;
+    }
+    else if constexpr (PORT == GPIO_PORT_C)
+    {
+        DDRC &= ~mask;
+    }
+    else
+    {
+        DDRD &= ~mask;
+    }
+    clear(mask); // no pull-up
+}
+
+template <uint8_t PIN>
+void FastPin<PIN>::set()
+{
+    GPIOPort<gpioPort(PIN)>::set(gpioMask(PIN));
+}
+
+template <uint8_t PIN>
+void FastPin<PIN>::clear()
+{
+    GPIOPort<gpioPort(PIN)>::clear(gpioMask(PIN));
+}
+
+template <uint8_t PIN>
+void FastPin<PIN>::write(uint8_t level)
+{
+    if (level)
+    {
+        set();
+    }
+    else
+    {
+        clear();
+    }
+}
+
+template <uint8_t PIN>
+uint8_t FastPin<PIN>::read()
+{
+    return (GPIOPort<gpioPort(PIN)>::read() & gpioMask(PIN)) ? HIGH : LOW;
+}
+
+template <uint8_t PIN>
+void FastPin<PIN>::makeOutput()
+{
+    GPIOPort<gpioPort(PIN)>::makeOutput(gpioMask(PIN));
+}
+
+template <uint8_t PIN>
+void FastPin<PIN>::makeInput()
+{
+    GPIOPort<gpioPort(PIN)>::makeInput(gpioMask(PIN));
+}
@@ -0,0 +1,101 @@
+#ifndef FrameProfiler_h
+#define FrameProfiler_h
+#include "Arduino.h"
+
+#define PROFILER_BUCKET_AMOUNT 8
+#define PROFILER_BUCKET_SHIFT 7
+
+/**
+ * @brief Measures the execution time of `STAGE_AMOUNT` named stages of a frame with microsecond resolution (based on micros(), i.e. steps of 4us on 16MHz boards).
+ * Each stage keeps its minimum, average and maximum duration and a histogram of its durations in fixed SRAM, 22 bytes per stage.
+ *
+ * The histogram has PROFILER_BUCKET_AMOUNT logarithmic buckets, each four times as wide as the previous one:
+ * bucket 0 counts durations below 128us, bucket 1 below 512us, bucket 2 below 2.048ms, ..., bucket 7 counts everything from 524ms upwards.
+ * Counters that would overflow halve the whole histogram (respectively sum and count of the average) of their stage, so old samples fade out instead of saturating.
+ *
+ * A stage is measured by enclosing it in begin(stage) and end(). Stages must not be nested.
+ *
+ * @tparam STAGE_AMOUNT Amount of stages to be profiled.
+ */
+template <uint8_t STAGE_AMOUNT>
+class FrameProfiler
+{
+public:
+    /**
+     * @brief Construct a new FrameProfiler object.
+     *
+     * @param stageNames Array of STAGE_AMOUNT stage names, with both the array and the names residing in flash memory (PROGMEM). Only used by dump(...).
+     */
+    FrameProfiler(const char *const *stageNames);
+
+    /**
+     * @brief Starts measuring a stage.
+     *
+     * @param stage The index of the stage.
+     */
+    void begin(uint8_t stage);
+
+    /**
+     * @brief Stops measuring the stage passed to the last call of begin(...) and records its duration.
+     */
+    void end();
+
+    /**
+     * @brief Discards all recorded durations.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the shortest recorded duration of a stage.
+     *
+     * @param stage The index of the stage.
+     * @return uint32_t The duration in us, 0 if the stage was not recorded yet.
+     */
+    uint32_t getMin(uint8_t stage);
+
+    /**
+     * @brief Returns the average recorded duration of a stage.
+     *
+     * @param stage The index of the stage.
+     * @return uint32_t The duration in us, 0 if the stage was not recorded yet.
+     */
+    uint32_t getAverage(uint8_t stage);
+
+    /**
+     * @brief Returns the longest recorded duration of a stage.
+     *
+     * @param stage The index of the stage.
+     * @return uint32_t The duration in us.
+     */
+    uint32_t getMax(uint8_t stage);
+
+    /**
+     * @brief Returns the value of a histogram bucket of a stage.
+     *
+     * @param stage The index of the stage.
+     * @param bucket The index of the bucket, 0..PROFILER_BUCKET_AMOUNT-1.
+     * @return uint8_t The (relative) amount of durations that fell into the bucket.
+     */
+    uint8_t getBucket(uint8_t stage, uint8_t bucket);
+
+    /**
+     * @brief Prints all stages as a table to the supplied output, e.g. a SoftwareSerial on a spare pin.
+     * One line per stage: name, min, avg and max in us, followed by the histogram buckets.
+     *
+     * @param output The Print object to write the table to.
+     */
+    void dump(Print &output);
+
+private:
+    const char *const *_stageNames;
+    uint8_t _currentStage;
+    uint32_t _stageStartTime;
+    uint32_t _min[STAGE_AMOUNT];
+    uint32_t _max[STAGE_AMOUNT];
+    uint32_t _sum[STAGE_AMOUNT];
+    uint16_t _count[STAGE_AMOUNT];
+    uint8_t _histogram[STAGE_AMOUNT][PROFILER_BUCKET_AMOUNT];
+};
+
+#include "FrameProfiler.tpp"
+#endif
@@ -0,0 +1,110 @@
+template <uint8_t STAGE_AMOUNT>
+FrameProfiler<STAGE_AMOUNT>::FrameProfiler(const char *const *stageNames) : _stageNames(stageNames), _currentStage(0), _stageStartTime(0)
+{
+    reset();
+}
+
+template <uint8_t STAGE_AMOUNT>
+void FrameProfiler<STAGE_AMOUNT>::begin(uint8_t stage)
+{
+    _currentStage = stage;
+    _stageStartTime = micros();
+}
+
+template <uint8_t STAGE_AMOUNT>
+void FrameProfiler<STAGE_AMOUNT>::end()
+{
+    uint32_t duration = micros() - _stageStartTime;
+    uint8_t stage = _currentStage;
+
+    _min[stage] = min(_min[stage], duration);
+    _max[stage] = max(_max[stage], duration);
+
+    if (_count[stage] == 0xFFFF || _sum[stage] > 0xFFFFFFFF - duration) // halve instead of overflowing, keeps the average
+    {
+        _sum[stage] >>= 1;
+        _count[stage] >>= 1;
+    }
+    _sum[stage] += duration;
+    _count[stage]++;
+
+    // find logarithmic bucket, each bucket is four times as wide as the previous one
+    uint8_t bucket = 0;
+    duration >>= PROFILER_BUCKET_SHIFT;
+    while (duration > 0 && bucket < PROFILER_BUCKET_AMOUNT - 1)
+    {
+        duration >>= 2;
+        bucket++;
+    }
+
+    if (_histogram[stage][bucket] == 0xFF) // halve instead of overflowing, keeps the shape of the histogram
+    {
+        for (uint8_t halvedBucket = 0; halvedBucket < PROFILER_BUCKET_AMOUNT; halvedBucket++)
+        {
+            _histogram[stage][halvedBucket] >>= 1;
+        }
+    }
+    _histogram[stage][bucket]++;
+}
+
+template <uint8_t STAGE_AMOUNT>
+void FrameProfiler<STAGE_AMOUNT>::reset()
+{
+    for (uint8_t stage = 0; stage < STAGE_AMOUNT; stage++)
+    {
+        _min[stage] = 0xFFFFFFFF;
+        _max[stage] = 0;
+        _sum[stage] = 0;
+        _count[stage] = 0;
+        for (uint8_t bucket = 0; bucket < PROFILER_BUCKET_AMOUNT; bucket++)
+        {
+            _histogram[stage][bucket] = 0;
+        }
+    }
+}
+
+template <uint8_t STAGE_AMOUNT>
+uint32_t FrameProfiler<STAGE_AMOUNT>::getMin(uint8_t stage)
+{
+    return _count[stage] ? _min[stage] : 0;
+}
+
+template <uint8_t STAGE_AMOUNT>
+uint32_t FrameProfiler<STAGE_AMOUNT>::getAverage(uint8_t stage)
+{
+    return _count[stage] ? _sum[stage] / _count[stage] : 0;
+}
+
+template <uint8_t STAGE_AMOUNT>
+uint32_t FrameProfiler<STAGE_AMOUNT>::getMax(uint8_t stage)
+{
+    return _max[stage];
+}
+
+template <uint8_t STAGE_AMOUNT>
+uint8_t FrameProfiler<STAGE_AMOUNT>::getBucket(uint8_t stage, uint8_t bucket)
+{
+    return _histogram[stage][bucket];
+}
+
+template <uint8_t STAGE_AMOUNT>
+void FrameProfiler<STAGE_AMOUNT>::dump(Print &output)
+{
+    output.println(F("stage\tmin\tavg\tmax\t<128u\t<512u\t<2m\t<8m\t<33m\t<131m\t<524m\tmore"));
+    for (uint8_t stage = 0; stage < STAGE_AMOUNT; stage++)
+    {
+        output.print((const __FlashStringHelper *)pgm_read_ptr(&_stageNames[stage]));
+        output.print('\t');
+        output.print(getMin(stage));
+        output.print('\t');
+        output.print(getAverage(stage));
+        output.print('\t');
+        output.print(getMax(stage));
+        for (uint8_t bucket = 0; bucket < PROFILER_BUCKET_AMOUNT; bucket++)
+        {
+            output.print('\t');
+            output.print(_histogram[stage][bucket]);
+        }
+        output.println();
+    }
+}
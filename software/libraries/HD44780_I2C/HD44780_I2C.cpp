@@ -0,0 +1,140 @@
+#include "HD44780_I2C.h"
+#include <Wire.h>
+
+HD44780_I2C::HD44780_I2C(uint8_t address, uint8_t columns, uint8_t rows) : _address(address), _columns(columns), _rows(rows), _displayControl(HD44780_DISPLAY_ON), _backlight(HD44780_PIN_BACKLIGHT), _transferLength(0)
+{
+}
+
+void HD44780_I2C::init(uint32_t clock)
+{
+    Wire.begin();
+    Wire.setClock(clock);
+
+    // Reset sequence from the HD44780 datasheet (figure 24), which also works if the display was left in 4-bit mode by an earlier run
+    delay(50);
+    queueNibble(0x30);
+    sendTransfer();
+    delayMicroseconds(4500);
+    queueNibble(0x30);
+    sendTransfer();
+    delayMicroseconds(4500);
+    queueNibble(0x30);
+    sendTransfer();
+    delayMicroseconds(150);
+    queueNibble(0x20); // switch to 4-bit mode, every byte from here on takes two nibbles
+    sendTransfer();
+
+    command(HD44780_FUNCTION_SET | HD44780_TWO_LINES);
+    command(HD44780_DISPLAY_CONTROL | _displayControl);
+    command(HD44780_ENTRY_MODE_SET | HD44780_ENTRY_LEFT);
+    clear();
+}
+
+void HD44780_I2C::clear()
+{
+    command(HD44780_CLEAR_DISPLAY);
+    delayMicroseconds(HD44780_CLEAR_US);
+}
+
+void HD44780_I2C::home()
+{
+    command(HD44780_RETURN_HOME);
+    delayMicroseconds(HD44780_CLEAR_US);
+}
+
+void HD44780_I2C::display()
+{
+    _displayControl |= HD44780_DISPLAY_ON;
+    command(HD44780_DISPLAY_CONTROL | _displayControl);
+}
+
+void HD44780_I2C::noDisplay()
+{
+    _displayControl &= ~HD44780_DISPLAY_ON;
+    command(HD44780_DISPLAY_CONTROL | _displayControl);
+}
+
+void HD44780_I2C::backlight()
+{
+    _backlight = HD44780_PIN_BACKLIGHT;
+    command(HD44780_DISPLAY_CONTROL | _displayControl); // the backlight pin is sent along with every byte, so any command applies it
+}
+
+void HD44780_I2C::noBacklight()
+{
+    _backlight = 0;
+    command(HD44780_DISPLAY_CONTROL | _displayControl);
+}
+
+void HD44780_I2C::setCursor(uint8_t column, uint8_t row)
+{
+    static const uint8_t ROW_OFFSETS[] = {0x00, 0x40, 0x14, 0x54};
+    row = min(row, _rows - 1);
+    queueByte(HD44780_SET_DDRAM_ADDRESS | (column + ROW_OFFSETS[row]), 0); // sent with the next characters
+}
+
+void HD44780_I2C::createChar(uint8_t location, const uint8_t *charmap)
+{
+    queueByte(HD44780_SET_CGRAM_ADDRESS | ((location & 0x07) << 3), 0);
+    for (uint8_t row = 0; row < 8; row++)
+    {
+        queueByte(charmap[row], HD44780_PIN_RS);
+    }
+    command(HD44780_SET_DDRAM_ADDRESS); // leave CGRAM, so following characters are written to the display again
+}
+
+size_t HD44780_I2C::write(uint8_t value)
+{
+    queueByte(value, HD44780_PIN_RS);
+    sendTransfer();
+    return 1;
+}
+
+size_t HD44780_I2C::write(const uint8_t *buffer, size_t size)
+{
+    for (size_t index = 0; index < size; index++)
+    {
+        queueByte(buffer[index], HD44780_PIN_RS);
+    }
+    sendTransfer();
+    return size;
+}
+
+void HD44780_I2C::queueNibble(uint8_t pins)
+{
+    if (_transferLength == 0)
+    {
+        Wire.beginTransmission(_address);
+    }
+
+    pins |= _backlight;
+    Wire.write(pins | HD44780_PIN_ENABLE); // the HD44780 latches the nibble on the falling edge of enable
+    Wire.write(pins);
+    _transferLength += 2;
+
+    if (_transferLength >= HD44780_TRANSFER_SIZE)
+    {
+        sendTransfer();
+    }
+}
+
+void HD44780_I2C::queueByte(uint8_t value, uint8_t mode)
+{
+    queueNibble((value & 0xF0) | mode);
+    queueNibble((value << 4) | mode);
+}
+
+void HD44780_I2C::sendTransfer()
+{
+    if (_transferLength == 0)
+        return;
+
+    Wire.endTransmission();
+    _transferLength = 0;
+}
+
+void HD44780_I2C::command(uint8_t value)
+{
+    queueByte(value, 0);
+    sendTransfer();
+}
@@ -0,0 +1,157 @@
+#ifndef HD44780_I2C_h
+#define HD44780_I2C_h
+#include "Arduino.h"
+
+#define HD44780_I2C_CLOCK_STANDARD 100000 // I2C standard mode, the clock PCF8574 backpacks are specified for
+#define HD44780_I2C_CLOCK_FAST 400000     // I2C fast mode. Out of the PCF8574's specification, but runs reliably on short wires to the display
+#define HD44780_TRANSFER_SIZE 32 // size of the Wire transmit buffer, 8 LCD bytes at 4 expander writes each
+#define HD44780_CLEAR_US 1600    // execution time of clear and home, the only commands that take longer than an I2C byte to transfer
+
+// pins of the PCF8574 I2C expander of the backpack
+#define HD44780_PIN_RS 0b00000001
+#define HD44780_PIN_RW 0b00000010
+#define HD44780_PIN_ENABLE 0b00000100
+#define HD44780_PIN_BACKLIGHT 0b00001000
+
+// HD44780 instructions
+#define HD44780_CLEAR_DISPLAY 0x01
+#define HD44780_RETURN_HOME 0x02
+#define HD44780_ENTRY_MODE_SET 0x04
+#define HD44780_DISPLAY_CONTROL 0x08
+#define HD44780_FUNCTION_SET 0x20
+#define HD44780_SET_CGRAM_ADDRESS 0x40
+#define HD44780_SET_DDRAM_ADDRESS 0x80
+#define HD44780_ENTRY_LEFT 0x02
+#define HD44780_DISPLAY_ON 0x04
+#define HD44780_TWO_LINES 0x08
+
+/**
+ * @brief Driver for HD44780 character displays attached via a PCF8574 I2C backpack, a drop-in replacement for LiquidCrystal_I2C.
+ * Bytes are sent to the display in 4-bit mode, as two nibbles that are each latched by a high and a low enable strobe.
+ * Instead of a Wire transmission per strobe, the strobes of up to 8 consecutive bytes are packed into a single transmission,
+ * so writing a character costs ~360us of bus time at 100kHz instead of ~1.3ms, or ~90us if the bus is opted into 400kHz on init().
+ * The HD44780 executes a byte within 37us, which is shorter than transferring the next one takes even at 400kHz,
+ * so no busy waiting is required except after clear() and home().
+ */
+class HD44780_I2C : public Print
+{
+public:
+    /**
+     * @brief Construct a new HD44780_I2C object. The display is not accessed until init() is called.
+     *
+     * @param address I2C address of the backpack.
+     * @param columns Amount of characters per line.
+     * @param rows Amount of lines.
+     */
+    HD44780_I2C(uint8_t address, uint8_t columns, uint8_t rows);
+
+    /**
+     * @brief Starts the I2C bus and initializes the display: 4-bit mode, display on, cursor off, backlight on, display cleared.
+     * Takes ~50ms, as the HD44780 needs time to power up.
+     *
+     * @param clock I2C clock in Hz. HD44780_I2C_CLOCK_FAST quarters the bus time per character, but is only reliable on short wires.
+     */
+    void init(uint32_t clock = HD44780_I2C_CLOCK_STANDARD);
+
+    /**
+     * @brief Clears the display and moves the cursor to the first cell.
+     */
+    void clear();
+
+    /**
+     * @brief Moves the cursor to the first cell.
+     */
+    void home();
+
+    /**
+     * @brief Turns the display on. The contents of the display are kept while it is turned off.
+     */
+    void display();
+
+    /**
+     * @brief Turns the display off.
+     */
+    void noDisplay();
+
+    /**
+     * @brief Turns the backlight on.
+     */
+    void backlight();
+
+    /**
+     * @brief Turns the backlight off.
+     */
+    void noBacklight();
+
+    /**
+     * @brief Moves the cursor to a cell. The cursor command is sent together with the characters written next, in the same transmission.
+     *
+     * @param column Column of the cell.
+     * @param row Line of the cell.
+     */
+    void setCursor(uint8_t column, uint8_t row);
+
+    /**
+     * @brief Defines one of the 8 custom glyphs, which are shown when writing the characters 0 to 7. Moves the cursor to the first cell.
+     *
+     * @param location [0..7] Character of the glyph.
+     * @param charmap 8 rows of the glyph, top to bottom, 5 bits each.
+     */
+    void createChar(uint8_t location, const uint8_t *charmap);
+
+    /**
+     * @brief Writes a character at the cursor, which then advances to the next cell.
+     *
+     * @param value The character.
+     * @return size_t Amount of characters written, always 1.
+     */
+    size_t write(uint8_t value) override;
+
+    /**
+     * @brief Writes a run of characters at the cursor, packed into as few transmissions as possible.
+     *
+     * @param buffer The characters.
+     * @param size Amount of characters.
+     * @return size_t Amount of characters written.
+     */
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+private:
+    uint8_t _address;
+    uint8_t _columns;
+    uint8_t _rows;
+    uint8_t _displayControl;
+    uint8_t _backlight;
+    // Amount of bytes in the Wire transmission currently being assembled, 0 if none is open.
+    uint8_t _transferLength;
+
+    /**
+     * @brief Adds a nibble, latched by a high and a low enable strobe, to the open transmission. Sends the transmission once it is full.
+     *
+     * @param pins Nibble in the upper 4 bits, RS pin in the lower ones.
+     */
+    void queueNibble(uint8_t pins);
+
+    /**
+     * @brief Adds a byte, as two nibbles, to the open transmission.
+     *
+     * @param value The byte.
+     * @param mode HD44780_PIN_RS for characters, 0 for instructions.
+     */
+    void queueByte(uint8_t value, uint8_t mode);
+
+    /**
+     * @brief Sends the open transmission, if any.
+     */
+    void sendTransfer();
+
+    /**
+     * @brief Sends an instruction, together with anything still queued.
+     *
+     * @param value The instruction.
+     */
+    void command(uint8_t value);
+};
+
+#endif
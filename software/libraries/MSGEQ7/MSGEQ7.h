@@ -1,21 +1,22 @@
 #ifndef MSGEQ7_h
 #define MSGEQ7_h
+#include <FastGPIO.h>
 #include "Arduino.h"
 
+template <uint8_t STROBE_PIN, uint8_t RESET_PIN, uint8_t DATA_PIN>
 class MSGEQ7
 {
 public:
-    MSGEQ7(uint8_t strobePin, uint8_t resetPin, uint8_t dataPin);
+    MSGEQ7();
     void init();
     void queryBands(uint16_t *targetArray);
     void queryBands(uint16_t *targetArray, const uint8_t samples, const uint8_t delayMs);
 
 private:
-    uint8_t _strobePin;
-    uint8_t _resetPin;
-    uint8_t _dataPin;
+    uint32_t _lastResetMs;
 
     void reset();
 };
 
+#include "MSGEQ7.tpp"
 #endif
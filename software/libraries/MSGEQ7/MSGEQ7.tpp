@@ -3,12 +3,15 @@
 
 /**
  * @brief Construct a new MSGEQ7 object.
+ * The pins are template parameters, so the strobe and reset pins are driven through their port registers, see FastPin.
+ * This keeps the strobe pulses at exactly the lengths the MSGEQ7 datasheet asks for and saves the pin lookups of digitalWrite() on every band.
  *
- * @param strobePin The arduino pin to which the strobe pin (pin 4 of the MSGEQ7) is connected.
- * @param resetPin The arduino pin to which the reset pin (pin 7 of the MSGEQ7) is connected.
- * @param dataPin The arduino analog pin to which the data pin (pin 3 of the MSGEQ7) is connected.
+ * @tparam STROBE_PIN The arduino pin to which the strobe pin (pin 4 of the MSGEQ7) is connected.
+ * @tparam RESET_PIN The arduino pin to which the reset pin (pin 7 of the MSGEQ7) is connected.
+ * @tparam DATA_PIN The arduino analog pin to which the data pin (pin 3 of the MSGEQ7) is connected.
  */
-MSGEQ7::MSGEQ7(uint8_t strobePin, uint8_t resetPin, uint8_t dataPin) : _strobePin(strobePin), _resetPin(resetPin), _dataPin(dataPin)
+template <uint8_t STROBE_PIN, uint8_t RESET_PIN, uint8_t DATA_PIN>
+MSGEQ7<STROBE_PIN, RESET_PIN, DATA_PIN>::MSGEQ7() : _lastResetMs(0)
 {
 }
 
@@ -17,10 +20,11 @@ MSGEQ7::MSGEQ7(uint8_t strobePin, uint8_t resetPin, uint8_t dataPin) : _strobePi
  * This MUST BE CALLED before the MSGEQ7 can function properly.
  * 
  */
-void MSGEQ7::init()
+template <uint8_t STROBE_PIN, uint8_t RESET_PIN, uint8_t DATA_PIN>
+void MSGEQ7<STROBE_PIN, RESET_PIN, DATA_PIN>::init()
 {
-    pinMode(_strobePin, OUTPUT);
-    pinMode(_resetPin, OUTPUT);
+    FastPin<STROBE_PIN>::makeOutput();
+    FastPin<RESET_PIN>::makeOutput();
     reset();
 }
 
@@ -36,22 +40,22 @@ void MSGEQ7::init()
  * Frequency(Hz):   63  160  400  1K  2.5K  6.25K  16K
  * targetArray[]:    0    1    2   3     4      5    6
  */
-void MSGEQ7::queryBands(uint16_t *targetArray)
+template <uint8_t STROBE_PIN, uint8_t RESET_PIN, uint8_t DATA_PIN>
+void MSGEQ7<STROBE_PIN, RESET_PIN, DATA_PIN>::queryBands(uint16_t *targetArray)
 {
-    static uint32_t lastResetMs = 0;
-    if (millis() - lastResetMs > 2000) // Reset the MSGEQ7 every two seconds.
-    {                                  // This forces the MSGEQ7 back onto the 63Hz band and is technically
-        reset();                       // not required, but a good safety feature in case the MSGEQ7's
-    }                                  // multiplexer and this code somehow get out of sync.
+    if (millis() - _lastResetMs > 2000) // Reset the MSGEQ7 every two seconds.
+    {                                   // This forces the MSGEQ7 back onto the 63Hz band and is technically
+        reset();                        // not required, but a good safety feature in case the MSGEQ7's
+    }                                   // multiplexer and this code somehow get out of sync.
 
     for (uint8_t band = 0; band < 7; band++)
     {
         delayMicroseconds(10);
-        targetArray[band] = analogRead(_dataPin);
+        targetArray[band] = analogRead(DATA_PIN);
         delayMicroseconds(50);
-        digitalWrite(_strobePin, HIGH);
+        FastPin<STROBE_PIN>::set();
         delayMicroseconds(18);
-        digitalWrite(_strobePin, LOW);
+        FastPin<STROBE_PIN>::clear();
     }
 }
 
@@ -65,7 +69,8 @@ void MSGEQ7::queryBands(uint16_t *targetArray)
  * @param samples The amount of samples to take, i.e. how many times queryBands(uint16_t *targetArray) should be called.
  * @param delayMs The amount of time to wait between calls, in ms.
  */
-void MSGEQ7::queryBands(uint16_t *targetArray, const uint8_t samples, const uint8_t delayMs)
+template <uint8_t STROBE_PIN, uint8_t RESET_PIN, uint8_t DATA_PIN>
+void MSGEQ7<STROBE_PIN, RESET_PIN, DATA_PIN>::queryBands(uint16_t *targetArray, const uint8_t samples, const uint8_t delayMs)
 {
     uint16_t averageAmplitudes[] = {0, 0, 0, 0, 0, 0, 0};
     for (uint8_t samplesTaken = 0; samplesTaken < samples; samplesTaken++)
@@ -97,12 +102,15 @@ void MSGEQ7::queryBands(uint16_t *targetArray, const uint8_t samples, const uint
  * @brief Resets the MSGEQ7. This forces the MSGEQ7's multiplexer back to the first frequency (63Hz).
  * 
  */
-void MSGEQ7::reset()
+template <uint8_t STROBE_PIN, uint8_t RESET_PIN, uint8_t DATA_PIN>
+void MSGEQ7<STROBE_PIN, RESET_PIN, DATA_PIN>::reset()
 {
-    digitalWrite(_strobePin, LOW);
-    digitalWrite(_resetPin, HIGH);
-    digitalWrite(_strobePin, HIGH);
-    digitalWrite(_strobePin, LOW);
-    digitalWrite(_resetPin, LOW);
+    FastPin<STROBE_PIN>::clear();
+    FastPin<RESET_PIN>::set();
+    FastPin<STROBE_PIN>::set();
+    delayMicroseconds(18); // the pins switch within cycles now, so the strobe pulse has to be held for the minimum width of the datasheet
+    FastPin<STROBE_PIN>::clear();
+    FastPin<RESET_PIN>::clear();
     delayMicroseconds(72);
+    _lastResetMs = millis();
 }
@@ -0,0 +1,36 @@
+#include "OverloadGovernor.h"
+
+OverloadGovernor::OverloadGovernor(uint32_t frameBudgetUs, uint8_t maxLevel, uint8_t recoveryFrames) : _frameBudgetUs(frameBudgetUs), _maxLevel(maxLevel), _recoveryFrames(recoveryFrames), _level(0), _framesWithHeadroom(0)
+{
+}
+
+uint8_t OverloadGovernor::update(uint32_t frameTimeUs)
+{
+    if (frameTimeUs > _frameBudgetUs - (_frameBudgetUs >> 2)) // under pressure, shed more work right away
+    {
+        _framesWithHeadroom = 0;
+        if (_level < _maxLevel)
+        {
+            _level++;
+        }
+        return _level;
+    }
+
+    if (frameTimeUs >= (_frameBudgetUs >> 1)) // neither pressure nor headroom, keep current level
+    {
+        _framesWithHeadroom = 0;
+        return _level;
+    }
+
+    if (_level > 0 && ++_framesWithHeadroom >= _recoveryFrames) // enough headroom for a while, restore some work
+    {
+        _framesWithHeadroom = 0;
+        _level--;
+    }
+    return _level;
+}
+
+uint8_t OverloadGovernor::getLevel()
+{
+    return _level;
+}
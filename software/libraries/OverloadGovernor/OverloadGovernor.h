@@ -0,0 +1,47 @@
+#ifndef OverloadGovernor_h
+#define OverloadGovernor_h
+#include "Arduino.h"
+
+/**
+ * @brief Watches the time it takes to complete each frame and derives an overload level from it, which the application uses to shed non-critical work.
+ * Level 0 means there is enough headroom. Every frame that takes longer than 3/4 of the frame budget raises the level by one, up to the maximum level.
+ * The level is lowered by one again once `recoveryFrames` consecutive frames took less than half of the budget, so work is restored step by step
+ * and the level does not oscillate around a single threshold.
+ *
+ */
+class OverloadGovernor
+{
+public:
+    /**
+     * @brief Construct a new OverloadGovernor object at level 0.
+     *
+     * @param frameBudgetUs The time available for a frame, in us.
+     * @param maxLevel The highest overload level.
+     * @param recoveryFrames Amount of consecutive frames with headroom required to lower the level by one.
+     */
+    OverloadGovernor(uint32_t frameBudgetUs, uint8_t maxLevel, uint8_t recoveryFrames);
+
+    /**
+     * @brief Records the time a frame took and updates the overload level accordingly. Must be called once per frame.
+     *
+     * @param frameTimeUs The time the frame took, in us, i.e. from when it was due until it was completed.
+     * @return uint8_t The updated overload level.
+     */
+    uint8_t update(uint32_t frameTimeUs);
+
+    /**
+     * @brief Returns the current overload level.
+     *
+     * @return uint8_t The overload level, 0..maxLevel.
+     */
+    uint8_t getLevel();
+
+private:
+    uint32_t _frameBudgetUs;
+    uint8_t _maxLevel;
+    uint8_t _recoveryFrames;
+    uint8_t _level;
+    uint8_t _framesWithHeadroom;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef SettingsStore_h
+#define SettingsStore_h
+#include <avr/eeprom.h>
+#include "Arduino.h"
+
+#define SETTINGS_SEQUENCE_MODULO 255 // sequence numbers count 0..254, so the 0xFF of erased EEPROM never continues a sequence
+#define SETTINGS_ERASED 0xFF
+
+/**
+ * @brief Keeps a record of settings in EEPROM, so they survive a power cycle.
+ *
+ * The EEPROM area is a log of slots, each holding a complete record: `[sequence][record][crc]`. Every write goes to the slot after the
+ * latest one, so the writes are spread over all slots and each EEPROM cell is only rewritten once per `slot amount` records.
+ * The sequence numbers of consecutive slots count up by one (modulo SETTINGS_SEQUENCE_MODULO), except at the latest record,
+ * after which the next slot holds the oldest record or is erased. restore() therefore finds the latest record by bisecting the sequence numbers,
+ * reading at most 9 of them (one per halving of at most 254 slots, plus the first one) and checking the CRC of at most two records.
+ * This bound is independent of the size of the log and of how often it was written.
+ *
+ * Writing a byte takes ~3.4ms, during which the EEPROM can not be accessed. Records are not written right away:
+ * save() only takes a copy, which is written once no further save() was requested for `settleMs`, so a series of changes results in a single record.
+ * The copy is then written by update(), one byte per call and only once the EEPROM finished the previous byte, so update() never waits for the EEPROM.
+ * The sequence number is written last, so a record that was cut off by a power loss is never taken for the latest one.
+ *
+ * @tparam RECORD Plain struct holding the settings. The CRC is seeded with its size, so records of a differently sized struct are not restored.
+ */
+template <class RECORD>
+class SettingsStore
+{
+public:
+    /**
+     * @brief Construct a new SettingsStore object. The EEPROM is not accessed until restore() is called.
+     *
+     * @param address First EEPROM address of the log.
+     * @param size Amount of EEPROM bytes the log may use, at least two slots of sizeof(RECORD) + 2 bytes.
+     * @param settleMs Time without further save() calls after which a saved record is written.
+     */
+    SettingsStore(uint16_t address, uint16_t size, uint16_t settleMs);
+
+    /**
+     * @brief Reads the latest valid record from the log. Must be called once before save() or update(), as it locates the slot written next.
+     * Reads at most 9 sequence numbers and two records.
+     *
+     * @param record Receives the latest record. Unchanged if there is none.
+     * @return true If a valid record was restored.
+     * @return false If the log is empty or corrupt. The log is then erased before the next record is written, which only takes a read per slot
+     * if the log was erased already.
+     */
+    bool restore(RECORD &record);
+
+    /**
+     * @brief Schedules a record to be written, settleMs after the last call. Records equal to the latest stored one are not written again.
+     *
+     * @param record The record, which is copied.
+     */
+    void save(const RECORD &record);
+
+    /**
+     * @brief Writes the next byte of a due record, unless the EEPROM is still busy with the previous one. Call this regularly, at least every ~3.4ms
+     * to write records as fast as the EEPROM allows. Returns immediately if nothing is due.
+     *
+     * @return true If a record is still to be written, which may be lost on a power loss.
+     * @return false If all saved records are stored.
+     */
+    bool update();
+
+private:
+    static constexpr uint8_t SLOT_SIZE = sizeof(RECORD) + 2; // sequence number and CRC
+
+    uint16_t _address;
+    uint8_t _slotAmount;
+    uint16_t _settleMs;
+    // Slot and sequence number of the latest record in the log. Initially the last slot, so the first record goes to the first slot.
+    uint8_t _latestSlot;
+    uint8_t _latestSequence;
+    // Latest record in the log, saved records equal to it are not written.
+    RECORD _stored;
+    bool _hasStored;
+    // Record to be written once settled.
+    RECORD _pending;
+    bool _hasPending;
+    uint32_t _pendingTimestamp;
+    // Slot currently being written, complete with sequence number and CRC, and the amount of its bytes already written. SLOT_SIZE if none is being written.
+    uint8_t _slot[SLOT_SIZE];
+    uint8_t _writtenBytes;
+    // Amount of slots whose sequence numbers were erased, before the first record is written into a corrupt log. _slotAmount if erased.
+    uint8_t _erasedSlots;
+
+    /**
+     * @brief Reads a slot and checks its CRC.
+     *
+     * @param slot Index of the slot.
+     * @param buffer Receives the slot, SLOT_SIZE bytes.
+     * @return true If the slot holds a valid record.
+     */
+    bool readSlot(uint8_t slot, uint8_t *buffer);
+
+    /**
+     * @brief Computes the CRC-8 of a slot's sequence number and record.
+     *
+     * @param buffer The slot.
+     * @return uint8_t The CRC.
+     */
+    static uint8_t crc(const uint8_t *buffer);
+
+    /**
+     * @brief Returns the EEPROM address of a byte of a slot, as expected by the avr-libc EEPROM functions.
+     */
+    uint8_t *slotAddress(uint8_t slot, uint8_t offset);
+};
+
+#include "SettingsStore.tpp"
+#endif
@@ -0,0 +1,134 @@
+#include "SettingsStore.h"
+#include "Arduino.h"
+
+template <class RECORD>
+SettingsStore<RECORD>::SettingsStore(uint16_t address, uint16_t size, uint16_t settleMs) : _address(address), _slotAmount(min(size / SLOT_SIZE, SETTINGS_SEQUENCE_MODULO - 1)), _settleMs(settleMs), _latestSlot(_slotAmount - 1), _latestSequence(SETTINGS_SEQUENCE_MODULO - 1), _hasStored(false), _hasPending(false), _pendingTimestamp(0), _writtenBytes(SLOT_SIZE), _erasedSlots(0)
+{
+}
+
+template <class RECORD>
+bool SettingsStore<RECORD>::restore(RECORD &record)
+{
+    uint8_t firstSequence = eeprom_read_byte(slotAddress(0, 0));
+    if (firstSequence == SETTINGS_ERASED) // erased log, or an erase that was cut off. Erasing again only reads the slots that are erased already
+        return false;
+
+    // Slots 0..latest continue the sequence of slot 0. Slots after the latest one are erased or hold older records, whose sequence numbers
+    // are off by the amount of slots, which never matches with less than SETTINGS_SEQUENCE_MODULO slots. So the latest slot can be bisected.
+    uint8_t latestSlot = 0;
+    uint8_t lastCandidate = _slotAmount - 1;
+    while (latestSlot < lastCandidate)
+    {
+        uint8_t slot = latestSlot + (lastCandidate - latestSlot + 1) / 2;
+        if (eeprom_read_byte(slotAddress(slot, 0)) == (firstSequence + slot) % SETTINGS_SEQUENCE_MODULO)
+        {
+            latestSlot = slot;
+        }
+        else
+        {
+            lastCandidate = slot - 1;
+        }
+    }
+
+    uint8_t buffer[SLOT_SIZE];
+    if (!readSlot(latestSlot, buffer)) // the latest record was damaged, fall back to the one before it
+    {
+        uint8_t latestSequence = buffer[0];
+        latestSlot = (latestSlot + _slotAmount - 1) % _slotAmount;
+        if (!readSlot(latestSlot, buffer) || buffer[0] != (latestSequence + SETTINGS_SEQUENCE_MODULO - 1) % SETTINGS_SEQUENCE_MODULO)
+        {
+            return false; // corrupt log, or written by something else. _erasedSlots stays 0, so it is erased before the next record is written
+        }
+    }
+
+    _erasedSlots = _slotAmount;
+    _latestSlot = latestSlot;
+    _latestSequence = buffer[0];
+    memcpy(&record, buffer + 1, sizeof(RECORD));
+    memcpy(&_stored, buffer + 1, sizeof(RECORD));
+    _hasStored = true;
+    return true;
+}
+
+template <class RECORD>
+void SettingsStore<RECORD>::save(const RECORD &record)
+{
+    if (_hasStored && memcmp(&record, &_stored, sizeof(RECORD)) == 0)
+    {
+        _hasPending = false; // changed back before it was written
+        return;
+    }
+
+    memcpy(&_pending, &record, sizeof(RECORD));
+    _hasPending = true;
+    _pendingTimestamp = millis();
+}
+
+template <class RECORD>
+bool SettingsStore<RECORD>::update()
+{
+    if (_writtenBytes == SLOT_SIZE) // no slot being written
+    {
+        if (!_hasPending || millis() - _pendingTimestamp < _settleMs)
+            return _hasPending;
+
+        if (!eeprom_is_ready())
+            return true;
+
+        if (_erasedSlots < _slotAmount) // the log was corrupt, erase all sequence numbers so restore() can not mistake old slots for records
+        {
+            eeprom_update_byte(slotAddress(_erasedSlots, 0), SETTINGS_ERASED);
+            _erasedSlots++;
+            return true;
+        }
+
+        _latestSlot = (_latestSlot + 1) % _slotAmount;
+        _latestSequence = (_latestSequence + 1) % SETTINGS_SEQUENCE_MODULO;
+        _slot[0] = _latestSequence;
+        memcpy(_slot + 1, &_pending, sizeof(RECORD));
+        _slot[SLOT_SIZE - 1] = crc(_slot);
+        memcpy(&_stored, &_pending, sizeof(RECORD));
+        _hasStored = true;
+        _hasPending = false;
+        _writtenBytes = 0;
+    }
+
+    if (!eeprom_is_ready())
+        return true;
+
+    uint8_t offset = (_writtenBytes + 1) % SLOT_SIZE; // record and CRC first, the sequence number that makes the slot the latest one last
+    eeprom_update_byte(slotAddress(_latestSlot, offset), _slot[offset]);
+    _writtenBytes++;
+    return _hasPending || _writtenBytes < SLOT_SIZE;
+}
+
+template <class RECORD>
+bool SettingsStore<RECORD>::readSlot(uint8_t slot, uint8_t *buffer)
+{
+    for (uint8_t offset = 0; offset < SLOT_SIZE; offset++)
+    {
+        buffer[offset] = eeprom_read_byte(slotAddress(slot, offset));
+    }
+    return buffer[0] != SETTINGS_ERASED && buffer[SLOT_SIZE - 1] == crc(buffer);
+}
+
+template <class RECORD>
+uint8_t SettingsStore<RECORD>::crc(const uint8_t *buffer)
+{
+    uint8_t crc = sizeof(RECORD);
+    for (uint8_t offset = 0; offset < SLOT_SIZE - 1; offset++)
+    {
+        crc ^= buffer[offset];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1); // CRC-8, polynomial x^8 + x^2 + x + 1
+        }
+    }
+    return crc;
+}
+
+template <class RECORD>
+uint8_t *SettingsStore<RECORD>::slotAddress(uint8_t slot, uint8_t offset)
+{
+    return (uint8_t *)(uintptr_t)(_address + slot * SLOT_SIZE + offset);
+}
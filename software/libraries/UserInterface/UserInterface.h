@@ -1,6 +1,6 @@
 #ifndef UserInterface_h
 #define UserInterface_h
-#include <LiquidCrystal_I2C.h>
+#include <HD44780_I2C.h>
 #include "Arduino.h"
 
 #define DISPLAY_WIDTH 16
@@ -8,16 +8,24 @@
 #define SCREEN_SAVER_OFFSET 15000
 #define VALUE_DISPLAY_WIDTH 5
 #define UNIT_DISPLAY_WIDTH 1
+#define NO_CURSOR 0xFF
+#define UNLIMITED_BYTES 0xFF // byte budget to update the screen completely, see SettingsDisplay::update()
+#define NAME_DISPLAY_WIDTH (DISPLAY_WIDTH - (2 + VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH)) // 2 for length of ": "
+#define BAR_GLYPH_ROWS 8 // pixel rows of a character cell, bars rise by one pixel row per level
+#define BAR_FULL_GLYPH 0xFF // full block of the HD44780 character ROM, custom glyphs 1 to 7 hold the partially filled cells
 
+/**
+ * @brief A page of the SettingsDisplay, exposing a single uint8_t variable to the user.
+ * Texts of a page (setting name and display aliases) stay in flash memory (PROGMEM) and are rendered into fixed-size character buffers on demand,
+ * so pages do not use the heap and take up only a few bytes of SRAM each.
+ */
 class SettingsPage
 {
 public:
-    const inline static String _SYMBOL_SPACE = String(" ");
-    
     /**
      * @brief Construct a new SettingsPage instance. Not to be used directly. Refer to SettingsPageFactory for SettingsPage intanciation.
      */
-    SettingsPage(uint8_t state, String settingName, uint8_t *linkedVariablePtr, uint8_t linkedVarMin, uint8_t linkedVarMax, char unitSymbol, String aliasList);
+    SettingsPage(uint8_t state, const char *settingName, uint8_t *linkedVariablePtr, uint8_t linkedVarMin, uint8_t linkedVarMax, char unitSymbol, const char *aliasList, uint8_t barAmount);
 
     /**
      * @brief Construct a new Settings Page object. Not to be used directly. Refer to SettingsPageFactory for SettingsPage intanciation.
@@ -69,6 +77,22 @@ public:
      */
     bool isMonitor();
 
+    /**
+     * @brief Checks whether this page is a bar graph. Bar graphs are Monitors that show an array of values as vertical bars over both lines of the display.
+     *
+     * @return true If the page is a bar graph.
+     * @return false If the page is not a bar graph.
+     */
+    bool isBarGraph();
+
+    /**
+     * @brief Checks whether the linked variable is shown as milliseconds with one decimal place.
+     *
+     * @return true If the linked variable holds tenths of a millisecond.
+     * @return false If the linked variable is shown as a whole number.
+     */
+    bool isMilliseconds();
+
     /**
      * @brief Decrements the linked variable, unless this button has been disabled upon creation of this SettingsPage.
      * 
@@ -98,27 +122,27 @@ public:
     bool plusButtonDisabled();
 
     /**
-     * @brief Get a rendered version of this page's complete header (top line).
-     * The returned String is pre-rendered therefore calling this function has a minimal perfomance impact.
+     * @brief Renders this page's complete header (top line). Format: ' Example: value' or 'Example.: value' if the setting name is too long.
+     * Bar graphs render the upper half of their bars instead, followed by the setting name.
      *
-     * @return String String which represents the entire top line of the page.
+     * @param line Buffer of at least DISPLAY_WIDTH + 1 characters, receives the header as zero-terminated string of DISPLAY_WIDTH characters.
      */
-    String getRenderedHeader();
+    void renderHeader(char *line);
 
     /**
-     * @brief Get a rendered version of this page's complete footer (bottom line).
-     * The returned String is pre-rendered therefore calling this function has a minimal perfomance impact.
+     * @brief Renders this page's complete footer (bottom line). If the page is selected, this shows the actions available in edit mode,
+     * otherwise it shows the default actions for navigating the pages. Bar graphs render the lower half of their bars, followed by the navigation actions.
      *
-     * @return String String which represents the bottom top line of the page.
+     * @param line Buffer of at least DISPLAY_WIDTH + 1 characters, receives the footer as zero-terminated string of DISPLAY_WIDTH characters.
      */
-    String getRenderedFooter();
+    void renderFooter(char *line);
 
     /**
-     * @brief Get a rendered version of this page's value.
+     * @brief Renders this page's value, including the unit symbol. Values are right-aligned, aliases are shown as supplied.
      *
-     * @return String String which represents the value (including unit) on this page.
+     * @param value Buffer of at least VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH + 1 characters, receives the value as zero-terminated string.
      */
-    String getRenderedValue();
+    void renderValue(char *value);
 
 private:
     uint8_t _state;
@@ -127,10 +151,21 @@ private:
     uint8_t _linkedVariableEditBuffer;
     uint8_t _linkedVariableMin;
     uint8_t _linkedVariableMax;
-    String _settingName;
-    String _footer;
+    const char *_settingName; // in PROGMEM
     char _unitSymbol;
-    String _aliasList;
+    const char *_aliasList; // in PROGMEM
+    uint8_t _aliasAmount;
+    uint8_t _barAmount;
+
+    /**
+     * @brief Renders a line of a bar graph: one bar per linked value, a space, then the text in the remaining columns.
+     * Each bar is DISPLAY_HEIGHT cells high and rises by one pixel row per 1/16 of the value range [0..255].
+     *
+     * @param line Buffer of at least DISPLAY_WIDTH + 1 characters, receives the line as zero-terminated string of DISPLAY_WIDTH characters.
+     * @param row Line of the display, which selects the part of the bars to render.
+     * @param text Text shown right of the bars, in PROGMEM. Right-aligned and trimmed to the remaining columns.
+     */
+    void renderBarGraph(char *line, uint8_t row, const char *text);
 
     /**
      * @brief Stores the supplied value to a storage location.
@@ -145,8 +180,8 @@ private:
     /**
      * @brief Load the value from a storage location.
      * This storage location is either the linked variable, or the linked variable buffer, depnding on whether change previews are on.
-     * If change previews are on, the value is read directly from the linked variable.
-     * If change previews are off, the value is read from the linked variable buffer.
+     * If change previews are on, or the page is not selected, the value is read directly from the linked variable.
+     * If change previews are off, the value is read from the linked variable buffer while the page is selected.
      *  
      * @return uint8_t The value loaded from the storage location.
      */
@@ -156,6 +191,7 @@ private:
 /**
  * @brief Constructs SettingsPage instances via finalize().
  * Once finalize is called, all parameters which have not been set explicitely using setter functions will assume default values.
+ * All texts handed to the factory must reside in flash memory (PROGMEM), e.g. `const char LIGHTS_NAME[] PROGMEM = "Lights";`.
  */
 struct SettingsPageFactory
 {
@@ -163,10 +199,10 @@ public:
     /**
      * @brief Construct a new SettingsPageFactory object.
      *
-     * @param settingName String to be displayed as the name of this setting.
+     * @param settingName Name of this setting, in PROGMEM. Names longer than NAME_DISPLAY_WIDTH are shortened on the display.
      * @param linkedVarPtr A uint8_t variable which is exposed to the user for modification on this SettingsPage.
      */
-    SettingsPageFactory(String settingName, uint8_t *linkedVarPtr);
+    SettingsPageFactory(const char *settingName, uint8_t *linkedVarPtr);
 
     /**
      * @brief Produces a SettingsPage from this SettingsPageFactory.
@@ -180,43 +216,51 @@ public:
      * @brief Disables button 0b01 when the page is selected.
      * Therefore, the linked variable can no longer be decremented when the page is selected (except for roll-overs).
      *
-     * @return SettingsPageFactory based on the set parameters of this SettingsPageFactory.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
      */
-    SettingsPageFactory disableMinusButton();
+    SettingsPageFactory &disableMinusButton();
 
     /**
      * @brief Disables button 0b11 when the page is selected.
      * Therefore, the linked variable can no longer be incremented when the page is selected (except for roll-overs).
      *
-     * @return SettingsPageFactory based on the set parameters of this SettingsPageFactory.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
      */
-    SettingsPageFactory disablePlusButton();
+    SettingsPageFactory &disablePlusButton();
 
     /**
      * @brief Set limits for the values the linked variable may be set to via the user interface.
      *
      * @param min Minimum value of the linked variable (inclusive).
      * @param max Minimum value of the linked variable (exclusive).
-     * @return SettingsPageFactory This instance of the SettingsPageFactory, with values updated.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
      */
-    SettingsPageFactory setLinkedVariableLimits(uint8_t min, uint8_t max);
+    SettingsPageFactory &setLinkedVariableLimits(uint8_t min, uint8_t max);
 
     /**
      * @brief Sets the unit to be displayed behind the value of the linked variable on the screen.
      *
      * @param unitSymbol A one-character unit symbol.
-     * @return SettingsPageFactory This instance of the SettingsPageFactory, with values updated.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
+     */
+    SettingsPageFactory &setLinkedVariableUnits(char unitSymbol);
+
+    /**
+     * @brief Shows the linked variable as milliseconds with one decimal place, e.g. `25.5ms` for 255, so it holds tenths of a millisecond.
+     * The value and the unit share the columns of the value and the unit symbol, so setLinkedVariableUnits() and setDisplayAlias() have no effect.
+     *
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
      */
-    SettingsPageFactory setLinkedVariableUnits(char unitSymbol);
+    SettingsPageFactory &showAsMilliseconds();
 
     /**
      * @brief Enables change previews.
      * With change previews enabled, changes made in edit mode will be applied immediately instead of only upon saving.
      * The user may then SAVE to keep these changes or BACK to discard the changes.
      *
-     * @return SettingsPageFactory This instance of the SettingsPageFactory, with values updated.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
      */
-    SettingsPageFactory enableChangePreviews();
+    SettingsPageFactory &enableChangePreviews();
 
     /**
      * @brief Turns this page into a Monitor.
@@ -229,22 +273,35 @@ public:
      * setLinkedVariableUnits() will add a unit symbol to be displayed behind the variable, as expected.
      * setDisplayAlias() will render the numbers provided by the underlying linked variable as the provided aliases, if possible.
      *
-     * @return SettingsPageFactory This instance of the SettingsPageFactory, with values updated.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
      */
-    SettingsPageFactory makeMonitor();
+    SettingsPageFactory &makeMonitor();
 
     /**
      * @brief Sets display aliases for the linked variable. These alias will replace the numbers of the linked variable with 5-character strings.
      * E.g. this may be used to replace 1 with "ON" and 0 with "OFF".
      *
-     * @param aliasList String object which represents a concatination of possible aliases. Must have a lenght of 5, 10, 15, 20, ... .
+     * @param aliasList Concatination of possible aliases, in PROGMEM. Must have a lenght of 5, 10, 15, 20, ... .
      * E.g. "   ON  OFF" could be used to introduce the two aliases "ON" and "OFF".
-     * @return SettingsPageFactory This instance of the SettingsPageFactory, with values updated.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
      */
-    SettingsPageFactory setDisplayAlias(String aliasList);
+    SettingsPageFactory &setDisplayAlias(const char *aliasList);
+
+    /**
+     * @brief Turns this page into a bar graph, a Monitor showing `barAmount` values as vertical bars, e.g. a spectrum.
+     * The linked variable is the first element of an array of `barAmount` values, each of which spans [0..255] regardless of setLinkedVariableLimits().
+     * Bars are drawn from custom glyphs, so only the columns of bars that changed are sent to the screen on updateMonitor().
+     * The setting name is shown right of the bars, shortened to the columns that are left.
+     *
+     * @param barAmount Amount of bars, at most DISPLAY_WIDTH - 4 to leave room for the navigation actions.
+     * @return SettingsPageFactory& This instance of the SettingsPageFactory, with values updated.
+     */
+    SettingsPageFactory &makeBarGraph(uint8_t barAmount);
 
 private:
-    // Stores the state of the page. Format: 0b000000
+    // Stores the state of the page. Format: 0b00000000
+    // 0b(0|1)0000000 encodes whether the linked variable is shown as milliseconds with one decimal place.
+    // 0b(0|1)000000 encodes whether the page is a bar graph (and therefore a Monitor page).
     // 0b(0|1)00000 encodes whether the button 0b01 "minus" is disabled when the page is selected (if this is 0, then this button can be used to decrement the linked variable)
     // 0b0(0|1)0000 encodes whether the button 0b11 "plus" is disabled when the page is selected (if this is 0, then this button can be used to increment the linked variable).
     // 0b00(0|1)000 encodes whether the page is currently selected.
@@ -252,26 +309,34 @@ private:
     // 0b0000(0|1)0 encodes whether the displayAlias should be used.
     // 0b00000(0|1) encodes whether the page is a Monitor page.
     uint8_t _state;
-    String _settingName;
+    const char *_settingName;
     uint8_t *_linkedVariablePtr;
     uint8_t _linkedVariableMin;
     uint8_t _linkedVariableMax;
     char _unitSymbol;
-    String _aliasList;
+    const char *_aliasList;
+    uint8_t _barAmount;
 };
 
 template <uint8_t PAGE_AMOUNT>
 class SettingsDisplay
 {
 public:
+    /**
+     * @brief Construct a new SettingsDisplay object.
+     *
+     * @param pages Array of PAGE_AMOUNT pages. The pages are not copied, so the array must outlive the SettingsDisplay and must not be const, as pages keep their edit state.
+     */
     SettingsDisplay(SettingsPage *pages);
 
     /**
      * @brief Initializes the connected 1602 display. This is necessary to establish communications over I2C.
+     * Also defines the custom glyphs bar graphs are drawn with.
      *
      * @param screenAdress I2C address of the screen.
+     * @param i2cClock I2C clock in Hz, see HD44780_I2C::init().
      */
-    void initializeDisplay(uint8_t screenAddress);
+    void initializeDisplay(uint8_t screenAddress, uint32_t i2cClock = HD44780_I2C_CLOCK_STANDARD);
 
     /**
      * @brief Inputs a command into this SettingsDisplay. This method is designed to be hooked up to user-controlled buttons.
@@ -295,6 +360,14 @@ public:
      */
     void setQuickSettingFunction(void (*quickSettingFunction)(bool));
 
+    /**
+     * @brief Sets a function to be executed whenever the user saves a page, e.g. to persist the settings.
+     * The function is called after the page stored its changes to the linked variable.
+     *
+     * @param saveFunction A function pointer. Must not take any parameters.
+     */
+    void setSaveFunction(void (*saveFunction)());
+
     /**
      * @brief Enables the screen saver (turns of the display) if the internal screen saver timeout has passed.
      * Call this function regularly (at least every 7500ms) to enable the screen saver feature.
@@ -303,7 +376,7 @@ public:
     void checkScreenSaver();
 
     /**
-     * @brief Enables Monitor pages to update their values whilst they are being displayed.
+     * @brief Enables Monitor pages to update their values whilst they are being displayed. Bar graphs are redrawn completely, as all bars may have changed.
      * Call this function regularly to keep updating the displayed values of Monitor pages.
      * If the page currently displayed is not a monitor page, or is not selected, then this function will return immediately.
      * Not calling this function will freeze the values displayed on Monitor pages.
@@ -312,13 +385,27 @@ public:
     void updateMonitor();
 
     /**
-     * @brief Prints the supplied Strings to the attached screen. The Strings are padded or trimmed to the width of a display line.
-     * This function is slow and should not be called inside loops.
+     * @brief Prints the supplied flash strings (see F()) to the attached screen. The strings are padded or trimmed to the width of a display line.
+     * This function sends the text to the screen right away, it is slow and should not be called inside loops.
      * 
      * @param header The string to be printed on the top line of the display.
      * @param footer The string to be printed on the bottom line of the display.
      */
-    void print(String header, String footer);
+    void print(const __FlashStringHelper *header, const __FlashStringHelper *footer);
+
+    /**
+     * @brief Sends pending changes of the frame to the screen, at most `byteBudget` bytes per call.
+     * Drawing (pages, values, monitors) only changes the frame, so it never waits for the screen. Call this regularly to keep the screen in sync;
+     * the screen then catches up over multiple calls without ever blocking for longer than `byteBudget` bytes take to transfer.
+     * Only cells that differ from what is currently shown are sent, runs of changed cells within a line are sent at once,
+     * and the cursor is only moved when the next changed cell is not the one the cursor advanced to anyways.
+     * Changes drawn before earlier ones were sent simply replace them.
+     *
+     * @param byteBudget Maximum amount of bytes (characters and commands) to send to the screen.
+     * @return true If changes are still pending.
+     * @return false If the screen shows the frame.
+     */
+    bool update(uint8_t byteBudget);
 
     /**
      * @brief Renders pages view. Must be called at least once after object creation, otherwise the user will have to press a button.
@@ -327,18 +414,31 @@ public:
     void showPages();
 
 private:
-    // Array of pages held by this SettingsDisplay.
-    SettingsPage _pages[PAGE_AMOUNT];
+    // Array of pages shown by this SettingsDisplay.
+    SettingsPage *_pages;
     // Index of the page currently shown on this SettingsDisplay.
     uint8_t _currentPageIndex;
     // Function pointer to the function to be executed as a default for button 0b00.
     bool _hasQuickSettingFunction;
     void (*_quickSettingFunction)(bool);
+    // Function pointer to the function to be executed after a page was saved, 0 if none.
+    void (*_saveFunction)();
     // Connected screen
-    LiquidCrystal_I2C _screen;
+    HD44780_I2C _screen;
     bool _screenInitialized;
     uint32_t _screenSaverTurnOnTimestamp;
     bool _screenSaverOn;
+    // Buffer pages render lines into before they are sent to the screen.
+    char _lineBuffer[DISPLAY_WIDTH + 1];
+    // Characters that should be shown on the screen, row by row. Drawing only changes this frame, update() sends it to the screen.
+    char _frame[DISPLAY_HEIGHT * DISPLAY_WIDTH];
+    // Shadow of the characters currently shown on the screen. Only cells that differ between frame and shadow are sent to the screen.
+    char _shadow[DISPLAY_HEIGHT * DISPLAY_WIDTH];
+    // Cell of the screen's cursor, which advances by one cell with every character written. NO_CURSOR if unknown.
+    uint8_t _cursorCell;
+    // Whether the screen should be turned on, and whether it is.
+    bool _displayOn;
+    bool _displayShown;
 
     /**
      * @brief Refreshes the full image on the screen. Segments being refreshed will flicker shortly.
@@ -351,6 +451,23 @@ private:
      *
      */
     void refreshValue();
+
+    /**
+     * @brief Prints a flash string on a line of the screen, padded with spaces or trimmed to the width of the display.
+     *
+     * @param row Line of the screen.
+     * @param text The string to be printed.
+     */
+    void printLine(uint8_t row, const __FlashStringHelper *text);
+
+    /**
+     * @brief Places text in the frame, starting at the supplied cell. The text is sent to the screen by update().
+     *
+     * @param column Column of the first character.
+     * @param row Line of the screen.
+     * @param text Zero-terminated text, must fit into the line.
+     */
+    void writeCells(uint8_t column, uint8_t row, const char *text);
     void nextPage();
     void previousPage();
     void selectPage();
@@ -5,57 +5,16 @@
 //
 // ======== ======== ======== ========
 
-SettingsPage::SettingsPage() : _state(0), _settingName(), _footer(), _linkedVariablePtr(0), _linkedVariableEditBuffer(0), _linkedVariableMin(0), _linkedVariableMax(255), _unitSymbol(' '), _aliasList()
+SettingsPage::SettingsPage() : _state(0), _linkedVariablePtr(0), _linkedVariableEditBuffer(0), _linkedVariableMin(0), _linkedVariableMax(255), _settingName(0), _unitSymbol(' '), _aliasList(0), _aliasAmount(0), _barAmount(0)
 {
 }
 
-SettingsPage::SettingsPage(uint8_t state, String settingName, uint8_t *linkedVariablePtr, uint8_t linkedVarMin, uint8_t linkedVarMax, char unitSymbol, String aliasList) : _state(state), _linkedVariablePtr(linkedVariablePtr), _linkedVariableEditBuffer((*linkedVariablePtr)), _linkedVariableMin(linkedVarMin), _linkedVariableMax(linkedVarMax), _unitSymbol(unitSymbol), _aliasList(aliasList)
+SettingsPage::SettingsPage(uint8_t state, const char *settingName, uint8_t *linkedVariablePtr, uint8_t linkedVarMin, uint8_t linkedVarMax, char unitSymbol, const char *aliasList, uint8_t barAmount) : _state(state), _linkedVariablePtr(linkedVariablePtr), _linkedVariableEditBuffer((*linkedVariablePtr)), _linkedVariableMin(linkedVarMin), _linkedVariableMax(linkedVarMax), _settingName(settingName), _unitSymbol(unitSymbol), _aliasList(aliasList), _aliasAmount(0), _barAmount(barAmount)
 {
-    // Precompute setting name displayed in header. Format: 'Example Sett.: '
-    // Calculate how much space is available for the settingName
-    int8_t targetLength = DISPLAY_WIDTH - (2 + VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH); // 2 for length of ": "
-    settingName.reserve(targetLength);
-
-    while (targetLength > settingName.length()) // add left whitespace padding if there is enough space
-    {
-        settingName = _SYMBOL_SPACE + settingName;
-    }
-
-    if (targetLength < settingName.length()) // shorten setting name if name is there is too little space
-    {
-        settingName = settingName.substring(0, targetLength - 1); // -1 for length of "."
-        settingName += String(F("."));
-    }
-    _settingName += settingName + String(F(": "));
-
-    // Precompute footer (full 2nd line of the screen)
-    _footer = String(F(""));
-    _footer.reserve(DISPLAY_WIDTH);
-    if (minusButtonDisabled())
-    {
-        _footer += _SYMBOL_SPACE;
-    }
-    else
-    {
-        _footer += String(F("-"));
-    }
-
-    _footer += _SYMBOL_SPACE + String(F("SAVE")) + _SYMBOL_SPACE;
-
-    if (plusButtonDisabled())
-    {
-        _footer += _SYMBOL_SPACE;
-    }
-    else
-    {
-        _footer += String(F("+"));
-    }
-
-    while (_footer.length() + 4 < DISPLAY_WIDTH) // footer length plus length of "BACK" (=4)
+    if (_state & 0b000010)
     {
-        _footer = _SYMBOL_SPACE + _footer;
+        _aliasAmount = strlen_P(aliasList) / VALUE_DISPLAY_WIDTH; // count aliases once, so rendering does not need to walk the alias list
     }
-    _footer = String(F("BACK")) + _footer;
 }
 
 bool SettingsPage::isSelected()
@@ -116,6 +75,16 @@ bool SettingsPage::isMonitor()
     return _state & 0b000001;
 }
 
+bool SettingsPage::isBarGraph()
+{
+    return _state & 0b1000000;
+}
+
+bool SettingsPage::isMilliseconds()
+{
+    return _state & 0b10000000;
+}
+
 void SettingsPage::storeValue(uint8_t value)
 {
     if (hasChangePreviewsEnabled())
@@ -130,7 +99,7 @@ void SettingsPage::storeValue(uint8_t value)
 
 uint8_t SettingsPage::loadValue()
 {
-    if (hasChangePreviewsEnabled())
+    if (hasChangePreviewsEnabled() || !isSelected()) // the linked variable may have been changed outside of edit mode, e.g. when settings are restored
     {
         return (*_linkedVariablePtr);
     }
@@ -164,35 +133,128 @@ bool SettingsPage::plusButtonDisabled()
     return _state & 0b010000;
 }
 
-String SettingsPage::getRenderedHeader()
+void SettingsPage::renderHeader(char *line)
 {
-    return _settingName + getRenderedValue();
+    if (isBarGraph())
+    {
+        renderBarGraph(line, 0, _settingName);
+        return;
+    }
+
+    // Format: ' Example: ', the setting name is right-aligned, or shortened to 'Example.: ' if there is too little space
+    uint8_t nameLength = strlen_P(_settingName);
+    if (nameLength > NAME_DISPLAY_WIDTH)
+    {
+        memcpy_P(line, _settingName, NAME_DISPLAY_WIDTH - 1); // -1 for length of "."
+        line[NAME_DISPLAY_WIDTH - 1] = '.';
+    }
+    else
+    {
+        memset(line, ' ', NAME_DISPLAY_WIDTH - nameLength);
+        memcpy_P(line + (NAME_DISPLAY_WIDTH - nameLength), _settingName, nameLength);
+    }
+    line[NAME_DISPLAY_WIDTH] = ':';
+    line[NAME_DISPLAY_WIDTH + 1] = ' ';
+
+    renderValue(line + NAME_DISPLAY_WIDTH + 2); // also terminates the line
 }
 
-String SettingsPage::getRenderedFooter()
+void SettingsPage::renderFooter(char *line)
 {
-    return _footer;
+    if (isBarGraph())
+    {
+        renderBarGraph(line, DISPLAY_HEIGHT - 1, PSTR("\177 \176")); // bar graphs are monitors, so only navigation is available
+        return;
+    }
+
+    if (isSelected()) // Format: 'BACK    - SAVE +', buttons that are disabled are left blank
+    {
+        memcpy_P(line, PSTR("BACK    - SAVE +"), DISPLAY_WIDTH);
+        if (minusButtonDisabled())
+        {
+            line[DISPLAY_WIDTH - 8] = ' ';
+        }
+        if (plusButtonDisabled())
+        {
+            line[DISPLAY_WIDTH - 1] = ' ';
+        }
+    }
+    else if (isMonitor()) // monitors can not be edited
+    {
+        memcpy_P(line, PSTR("FUNC    \177      \176"), DISPLAY_WIDTH);
+    }
+    else
+    {
+        memcpy_P(line, PSTR("FUNC    \177 EDIT \176"), DISPLAY_WIDTH);
+    }
+    line[DISPLAY_WIDTH] = '\0';
 }
 
-String SettingsPage::getRenderedValue()
+void SettingsPage::renderValue(char *value)
 {
-    String linkedVariableValue;
-    linkedVariableValue.reserve(VALUE_DISPLAY_WIDTH);
-    if (_state & 0b000010) // use alias instead of raw values
+    if (isMilliseconds()) // Format: '25.5ms', tenths right-aligned with left whitespace padding and the decimal point before the last digit
     {
-        uint8_t aliasIndex = (loadValue() % (_aliasList.length() / VALUE_DISPLAY_WIDTH)) * VALUE_DISPLAY_WIDTH;
-        linkedVariableValue = _aliasList.substring(aliasIndex, aliasIndex + VALUE_DISPLAY_WIDTH);
+        uint8_t number = loadValue();
+        for (int8_t digit = VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH - 3; digit >= 0; digit--)
+        {
+            if (digit == VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH - 4)
+            {
+                value[digit] = '.';
+                continue;
+            }
+            value[digit] = (number || digit >= VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH - 5) ? '0' + number % 10 : ' ';
+            number /= 10;
+        }
+        value[VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH - 2] = 'm';
+        value[VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH - 1] = 's';
+        value[VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH] = '\0';
+        return;
     }
-    else // use raw values
+
+    if (_aliasAmount) // use alias instead of raw values
+    {
+        memcpy_P(value, _aliasList + (loadValue() % _aliasAmount) * VALUE_DISPLAY_WIDTH, VALUE_DISPLAY_WIDTH);
+    }
+    else // use raw values, right-aligned with left whitespace padding
     {
-        linkedVariableValue = String(loadValue());
+        uint8_t number = loadValue();
+        for (int8_t digit = VALUE_DISPLAY_WIDTH - 1; digit >= 0; digit--)
+        {
+            value[digit] = (number || digit == VALUE_DISPLAY_WIDTH - 1) ? '0' + number % 10 : ' ';
+            number /= 10;
+        }
     }
+    value[VALUE_DISPLAY_WIDTH] = _unitSymbol; // unitSymbol is ' ' if no unit is set
+    value[VALUE_DISPLAY_WIDTH + UNIT_DISPLAY_WIDTH] = '\0';
+}
 
-    while (linkedVariableValue.length() < VALUE_DISPLAY_WIDTH) // add left whitespace padding if there is enough space
+void SettingsPage::renderBarGraph(char *line, uint8_t row, const char *text)
+{
+    uint8_t rowBase = (DISPLAY_HEIGHT - 1 - row) * BAR_GLYPH_ROWS; // level at which the bars enter this row
+    for (uint8_t bar = 0; bar < _barAmount; bar++)
     {
-        linkedVariableValue = _SYMBOL_SPACE + linkedVariableValue;
+        uint8_t level = ((uint16_t)_linkedVariablePtr[bar] * (DISPLAY_HEIGHT * BAR_GLYPH_ROWS + 1)) >> 8; // [0..255] to [0..16]
+        uint8_t fill = (level > rowBase) ? min(level - rowBase, BAR_GLYPH_ROWS) : 0;
+        if (fill == 0)
+        {
+            line[bar] = ' ';
+        }
+        else if (fill == BAR_GLYPH_ROWS)
+        {
+            line[bar] = BAR_FULL_GLYPH;
+        }
+        else
+        {
+            line[bar] = fill; // custom glyph with `fill` pixel rows, see SettingsDisplay::initializeDisplay()
+        }
     }
-    return linkedVariableValue + String(_unitSymbol); // return rendered value plus unitSymbol (the latter is ' ' if no unit is set)
+
+    // right-align the text in the remaining columns, one column is kept free to separate it from the bars
+    uint8_t textWidth = DISPLAY_WIDTH - (_barAmount + 1);
+    uint8_t textLength = min(strlen_P(text), textWidth);
+    memset(line + _barAmount, ' ', DISPLAY_WIDTH - _barAmount - textLength);
+    memcpy_P(line + DISPLAY_WIDTH - textLength, text, textLength);
+    line[DISPLAY_WIDTH] = '\0';
 }
 
 // ======== SETTINGS PAGE FACTORY ========
@@ -202,60 +264,74 @@ String SettingsPage::getRenderedValue()
 //
 // ======== ======== ======== ========
 
-SettingsPageFactory::SettingsPageFactory(String settingName, uint8_t *linkedVariablePtr) : _settingName(settingName), _linkedVariablePtr(linkedVariablePtr), _state(0), _linkedVariableMin(0), _linkedVariableMax(255), _unitSymbol(' '), _aliasList("")
+SettingsPageFactory::SettingsPageFactory(const char *settingName, uint8_t *linkedVariablePtr) : _state(0), _settingName(settingName), _linkedVariablePtr(linkedVariablePtr), _linkedVariableMin(0), _linkedVariableMax(255), _unitSymbol(' '), _aliasList(0), _barAmount(0)
 {
 }
 
 SettingsPage SettingsPageFactory::finalize()
 {
-    return SettingsPage(_state, _settingName, _linkedVariablePtr, _linkedVariableMin, _linkedVariableMax, _unitSymbol, _aliasList);
+    return SettingsPage(_state, _settingName, _linkedVariablePtr, _linkedVariableMin, _linkedVariableMax, _unitSymbol, _aliasList, _barAmount);
 }
 
-SettingsPageFactory SettingsPageFactory::disableMinusButton()
+SettingsPageFactory &SettingsPageFactory::disableMinusButton()
 {
     _state = _state | 0b100000;
     return *this;
 }
 
-SettingsPageFactory SettingsPageFactory::disablePlusButton()
+SettingsPageFactory &SettingsPageFactory::disablePlusButton()
 {
     _state = _state | 0b010000;
     return *this;
 }
 
-SettingsPageFactory SettingsPageFactory::setLinkedVariableLimits(uint8_t min, uint8_t max)
+SettingsPageFactory &SettingsPageFactory::setLinkedVariableLimits(uint8_t min, uint8_t max)
 {
     _linkedVariableMin = min;
     _linkedVariableMax = max;
     return *this;
 }
 
-SettingsPageFactory SettingsPageFactory::setLinkedVariableUnits(char unitSymbol)
+SettingsPageFactory &SettingsPageFactory::setLinkedVariableUnits(char unitSymbol)
 {
     _unitSymbol = unitSymbol;
     return *this;
 }
 
-SettingsPageFactory SettingsPageFactory::enableChangePreviews()
+SettingsPageFactory &SettingsPageFactory::showAsMilliseconds()
+{
+    _state = _state | 0b10000000;
+    return *this;
+}
+
+SettingsPageFactory &SettingsPageFactory::enableChangePreviews()
 {
     _state = _state | 0b00000100;
     return *this;
 }
 
-SettingsPageFactory SettingsPageFactory::makeMonitor()
+SettingsPageFactory &SettingsPageFactory::makeMonitor()
 {
     enableChangePreviews();
     _state = _state | 0b00000001;
     return *this;
 }
 
-SettingsPageFactory SettingsPageFactory::setDisplayAlias(String aliasList)
+SettingsPageFactory &SettingsPageFactory::setDisplayAlias(const char *aliasList)
 {
     _state = _state | 0b00000010;
     _aliasList = aliasList;
     return *this;
 }
 
+SettingsPageFactory &SettingsPageFactory::makeBarGraph(uint8_t barAmount)
+{
+    makeMonitor();
+    _state = _state | 0b01000000;
+    _barAmount = barAmount;
+    return *this;
+}
+
 // ======== SETTINGS DISPLAY ========
 //
 //
@@ -264,20 +340,33 @@ SettingsPageFactory SettingsPageFactory::setDisplayAlias(String aliasList)
 // ======== ======== ======== ========
 
 template <uint8_t PAGE_AMOUNT>
-SettingsDisplay<PAGE_AMOUNT>::SettingsDisplay(SettingsPage *pages) : _currentPageIndex(0), _quickSettingFunction(0), _hasQuickSettingFunction(false), _screen(0, 0, 0), _screenInitialized(false), _screenSaverTurnOnTimestamp(0), _screenSaverOn(false)
+SettingsDisplay<PAGE_AMOUNT>::SettingsDisplay(SettingsPage *pages) : _pages(pages), _currentPageIndex(0), _quickSettingFunction(0), _hasQuickSettingFunction(false), _saveFunction(0), _screen(0, 0, 0), _screenInitialized(false), _screenSaverTurnOnTimestamp(0), _screenSaverOn(false), _cursorCell(NO_CURSOR), _displayOn(true), _displayShown(true)
 {
-    for (int i = 0; i < PAGE_AMOUNT; i++)
-    {
-        _pages[i] = pages[i];
-    }
+    memset(_frame, ' ', sizeof(_frame));
+    memset(_shadow, ' ', sizeof(_shadow));
 }
 
 template <uint8_t PAGE_AMOUNT>
-void SettingsDisplay<PAGE_AMOUNT>::initializeDisplay(uint8_t screenAddress)
+void SettingsDisplay<PAGE_AMOUNT>::initializeDisplay(uint8_t screenAddress, uint32_t i2cClock)
 {
-    _screen = LiquidCrystal_I2C(screenAddress, 16, 2);
-    _screen.init();
+    _screen = HD44780_I2C(screenAddress, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    _screen.init(i2cClock);
+
+    // custom glyphs 1 to 7 are cells filled with as many pixel rows from the bottom. Glyph 0 stays unused, as '\0' terminates text
+    uint8_t glyph[BAR_GLYPH_ROWS];
+    for (uint8_t fill = 1; fill < BAR_GLYPH_ROWS; fill++)
+    {
+        for (uint8_t pixelRow = 0; pixelRow < BAR_GLYPH_ROWS; pixelRow++)
+        {
+            glyph[pixelRow] = (pixelRow >= BAR_GLYPH_ROWS - fill) ? 0b11111 : 0;
+        }
+        _screen.createChar(fill, glyph);
+    }
+
     _screen.clear();
+    memset(_shadow, ' ', sizeof(_shadow)); // clear() blanks the screen and homes the cursor
+    _cursorCell = 0;
+    _screenInitialized = true;
 }
 
 template <uint8_t PAGE_AMOUNT>
@@ -359,6 +448,12 @@ void SettingsDisplay<PAGE_AMOUNT>::setQuickSettingFunction(void (*quickSettingFu
     _hasQuickSettingFunction = true;
 }
 
+template <uint8_t PAGE_AMOUNT>
+void SettingsDisplay<PAGE_AMOUNT>::setSaveFunction(void (*saveFunction)())
+{
+    _saveFunction = saveFunction;
+}
+
 template <uint8_t PAGE_AMOUNT>
 void SettingsDisplay<PAGE_AMOUNT>::checkScreenSaver()
 {
@@ -369,7 +464,7 @@ void SettingsDisplay<PAGE_AMOUNT>::checkScreenSaver()
         return;
 
     // turn on screen saver, also discard any pending changes
-    _screen.noDisplay();
+    _displayOn = false;
     deselectPage(true);
     _screenSaverOn = true;
 }
@@ -391,6 +486,10 @@ void SettingsDisplay<PAGE_AMOUNT>::deselectPage(bool discardChanges)
     else
     {
         _pages[_currentPageIndex].deselectSave();
+        if (_saveFunction)
+        {
+            _saveFunction();
+        }
     }
     refreshAll();
 }
@@ -412,38 +511,96 @@ void SettingsDisplay<PAGE_AMOUNT>::previousPage()
 template <uint8_t PAGE_AMOUNT>
 void SettingsDisplay<PAGE_AMOUNT>::refreshAll()
 {
-    _screen.setCursor(0, 0);
-    _screen.print(_pages[_currentPageIndex].getRenderedHeader());
+    _pages[_currentPageIndex].renderHeader(_lineBuffer);
+    writeCells(0, 0, _lineBuffer);
 
-    // footer
-    _screen.setCursor(0, 1);
-    if (_pages[_currentPageIndex].isSelected())
-    { // if page is selected, get page specific footer
-        _screen.print(_pages[_currentPageIndex].getRenderedFooter());
+    _pages[_currentPageIndex].renderFooter(_lineBuffer); // page specific footer if the page is selected, default footer otherwise
+    writeCells(0, 1, _lineBuffer);
+}
+
+template <uint8_t PAGE_AMOUNT>
+void SettingsDisplay<PAGE_AMOUNT>::refreshValue()
+{
+    _pages[_currentPageIndex].renderValue(_lineBuffer);
+    writeCells(DISPLAY_WIDTH - (VALUE_DISPLAY_WIDTH + 1), 0, _lineBuffer); // -1 is from unit symbol, which is one character
+}
+
+template <uint8_t PAGE_AMOUNT>
+void SettingsDisplay<PAGE_AMOUNT>::printLine(uint8_t row, const __FlashStringHelper *text)
+{
+    const char *textPtr = reinterpret_cast<const char *>(text);
+    uint8_t textLength = min(strlen_P(textPtr), DISPLAY_WIDTH);
+    memcpy_P(_lineBuffer, textPtr, textLength);
+    memset(_lineBuffer + textLength, ' ', DISPLAY_WIDTH - textLength);
+    _lineBuffer[DISPLAY_WIDTH] = '\0';
+
+    writeCells(0, row, _lineBuffer);
+}
+
+template <uint8_t PAGE_AMOUNT>
+void SettingsDisplay<PAGE_AMOUNT>::writeCells(uint8_t column, uint8_t row, const char *text)
+{
+    char *frameCell = &_frame[row * DISPLAY_WIDTH + column];
+    while (*text)
+    {
+        *frameCell++ = *text++;
     }
-    else
-    { // page is not selected, generate a default footer
-        String defaultFooter = String(F("FUNC    "));
-        defaultFooter += String(F("\177")) + SettingsPage::_SYMBOL_SPACE;
-        if (_pages[_currentPageIndex].isMonitor())
+}
+
+template <uint8_t PAGE_AMOUNT>
+bool SettingsDisplay<PAGE_AMOUNT>::update(uint8_t byteBudget)
+{
+    if (!_screenInitialized)
+        return false;
+
+    if (_displayShown != _displayOn) // turning the screen on or off takes one command
+    {
+        if (byteBudget == 0)
+            return true;
+
+        if (_displayOn)
         {
-            defaultFooter += SettingsPage::_SYMBOL_SPACE + SettingsPage::_SYMBOL_SPACE + SettingsPage::_SYMBOL_SPACE + SettingsPage::_SYMBOL_SPACE;
+            _screen.display();
         }
         else
         {
-            defaultFooter += String(F("EDIT"));
+            _screen.noDisplay();
         }
-        defaultFooter += SettingsPage::_SYMBOL_SPACE + String(F("\176"));
-
-        _screen.print(defaultFooter);
+        _displayShown = _displayOn;
+        byteBudget--;
     }
-}
 
-template <uint8_t PAGE_AMOUNT>
-void SettingsDisplay<PAGE_AMOUNT>::refreshValue()
-{
-    _screen.setCursor(DISPLAY_WIDTH - (VALUE_DISPLAY_WIDTH + 1), 0); // -1 is from unit symbol, which is one character
-    _screen.print(_pages[_currentPageIndex].getRenderedValue());
+    uint8_t cell = 0;
+    while (cell < DISPLAY_HEIGHT * DISPLAY_WIDTH)
+    {
+        if (_frame[cell] == _shadow[cell]) // cell already shows this character
+        {
+            cell++;
+            continue;
+        }
+
+        // collect the run of changed cells starting here, as far as the line and the budget allow
+        uint8_t cost = (_cursorCell == cell) ? 0 : 1; // cursor move if the cursor is elsewhere
+        uint8_t lineEnd = (cell / DISPLAY_WIDTH + 1) * DISPLAY_WIDTH;
+        uint8_t runEnd = cell;
+        while (runEnd < lineEnd && _frame[runEnd] != _shadow[runEnd] && cost + (runEnd - cell) < byteBudget)
+        {
+            runEnd++;
+        }
+        if (runEnd == cell)
+            return true;
+
+        if (_cursorCell != cell)
+        {
+            _screen.setCursor(cell % DISPLAY_WIDTH, cell / DISPLAY_WIDTH); // sent together with the run
+        }
+        _screen.write((const uint8_t *)&_frame[cell], runEnd - cell);
+        memcpy(&_shadow[cell], &_frame[cell], runEnd - cell);
+        _cursorCell = (runEnd == lineEnd) ? NO_CURSOR : runEnd; // the cursor does not wrap to the next line
+        byteBudget -= cost + (runEnd - cell);
+        cell = runEnd;
+    }
+    return false;
 }
 
 template <uint8_t PAGE_AMOUNT>
@@ -455,7 +612,7 @@ bool SettingsDisplay<PAGE_AMOUNT>::setScreenSaverTimestamp(uint16_t offset)
     if (_screenSaverOn)
     {
         // turn off screen saver if it was on
-        _screen.display();
+        _displayOn = true;
         _screenSaverOn = false;
 
         return true;
@@ -476,36 +633,21 @@ void SettingsDisplay<PAGE_AMOUNT>::updateMonitor()
     if (!_pages[_currentPageIndex].isMonitor()) // if the page is not a monitor, return
         return;
 
+    if (_pages[_currentPageIndex].isBarGraph())
+    {
+        refreshAll(); // bars span both lines, only the columns of bars that changed are sent by update()
+        return;
+    }
+
     refreshValue(); // refresh value if the page is selected and a monitor
 }
 
 template <uint8_t PAGE_AMOUNT>
-void SettingsDisplay<PAGE_AMOUNT>::print(String header, String footer)
+void SettingsDisplay<PAGE_AMOUNT>::print(const __FlashStringHelper *header, const __FlashStringHelper *footer)
 {
-    if (header.length() > DISPLAY_WIDTH)
-    {
-        header = header.substring(0,DISPLAY_WIDTH);
-    }
-
-    while (header.length() < DISPLAY_WIDTH)
-    {
-        header += SettingsPage::_SYMBOL_SPACE;
-    }
-
-    if (footer.length() > DISPLAY_WIDTH)
-    {
-        footer = footer.substring(0, DISPLAY_WIDTH);
-    }
-
-    while (footer.length() < DISPLAY_WIDTH)
-    {
-        footer += SettingsPage::_SYMBOL_SPACE;
-    }
-
-    _screen.setCursor(0,0);
-    _screen.print(header);
-    _screen.setCursor(0, 1);
-    _screen.print(footer);
+    printLine(0, header);
+    printLine(1, footer);
+    update(UNLIMITED_BYTES);
 }
 
 template <uint8_t PAGE_AMOUNT>
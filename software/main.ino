@@ -1,15 +1,46 @@
 #include <MSGEQ7.h>
 #include <DMXFixture.h>
+#include <FixtureBank.h>
+#include <ProfileRotation.h>
+#include <FrameInterpolator.h>
 #include <NumericHistory.h>
-#include <LatchedButton.h>
+#include <DecimatingHistory.h>
+#include <ButtonEvents.h>
 #include <UserInterface.h>
+#include <CooperativeScheduler.h>
+#include <FrameProfiler.h>
+#include <OverloadGovernor.h>
+#include <SettingsStore.h>
+
+// #define PROFILER_DUMP_PIN 10 // uncomment to print the profiler table to a serial terminal (9600 baud) connected to this pin. The hardware serial port is taken by DMX.
+#ifdef PROFILER_DUMP_PIN
+#include <SoftwareSerial.h>
+#endif
 
 // ================================================================
 //                           CONSTANTS
 // ================================================================
 const uint8_t BRIGHTNESS_CAP = 217;            // 85% max brightness to increase LED lifetime
 const uint16_t PROFILE_CYCLE_PERIOD_MS = 5000; // amount of milliseconds until the profile assignments between lamps is rotated.
-const uint8_t FRAME_PERIOD_MS = 66;            // target value for the duration of a single frame. If the frame takes less then this, the processor will wait before moving on to the next frame.
+const uint8_t FRAME_PERIOD_MS = 66;            // period at which the lights are rendered from the audio signal.
+const uint8_t AUDIO_PERIOD_MS = 11;            // period at which the audio signal is sampled. All samples taken during a frame are averaged before rendering.
+const uint8_t BUTTON_PERIOD_MS = 22;           // period at which button events are handed to the user interface and held buttons are probed.
+const uint16_t BUTTON_HOLD_MS = 1000;          // time a button has to be held until it repeats.
+const uint8_t BUTTON_REPEAT_MS = 66;           // period at which a held button repeats.
+const uint16_t BUTTON_DOUBLE_PRESS_MS = 400;   // a second press of a button within this time requests the alternate action of the button.
+const uint16_t MONITOR_PERIOD_MS = 250;        // period at which monitor pages are refreshed.
+const uint8_t SCREEN_PERIOD_MS = 22;           // period at which pending changes of the user interface are sent to the LCD.
+const uint8_t SCREEN_BYTES_PER_UPDATE = 16;    // maximum amount of bytes sent to the LCD per update, bounds the time a screen update takes (~90us per byte).
+const uint16_t SCREEN_SAVER_PERIOD_MS = 1000;  // period at which the screen saver checks whether it should turn on.
+const uint16_t PROFILER_DUMP_PERIOD_MS = 5000; // period at which the profiler table is printed, if PROFILER_DUMP_PIN is defined.
+const uint16_t SETTINGS_SETTLE_MS = 5000;      // time without further changes after which changed settings are written to EEPROM, so a series of changes results in a single write.
+const uint8_t SETTINGS_STORE_PERIOD_MS = 4;    // period at which saved settings are written to EEPROM, one byte per period. Writing a byte takes ~3.4ms.
+const uint16_t SPLASH_MS = 1000;               // time after startup until the splash screen is replaced by the settings pages. The lights run in the meantime.
+const uint16_t GAIN_SAVE_PERIOD_MS = 60000;    // period at which the learned amplification factor is saved, if it changed. Every EEPROM cell lasts 100000 writes, spread over ~85 records.
+const uint8_t OVERLOAD_DEFER = 1;              // overload level from which monitor updates, the screen saver and profile rotation are deferred.
+const uint8_t OVERLOAD_REDUCE_AUDIO = 2;       // overload level from which the audio signal is sampled at half the rate.
+const uint8_t OVERLOAD_RECOVERY_FRAMES = 30;   // amount of frames with headroom until the overload level is lowered again.
+const uint8_t DMX_FRAME_PERIOD_MS = 23;        // duration of a single DMX frame. Full 512-slot frames are sent at roughly 44Hz. Light changes are spread over FRAME_PERIOD_MS / DMX_FRAME_PERIOD_MS DMX frames.
 const uint8_t AUDIO_BANDS = 7;                 // amount of audio bands provided by the FFT chip. The MSGEQ7 provides 7 bands.
 const uint16_t AUDIO_BAND_MAX = 1023;          // maximum value to expect from the analoge audio signal 1023 = 10-bit ADC
 const uint8_t DMX_CHANNEL_MAX = 255;           // maximum value allowed on a DMX channel. The DMX spec defines this as 255.
@@ -20,142 +51,466 @@ const float AMP_FACTOR_MIN = 0.0078125;        // minimal allowed amplification
 // ================================================================
 //                         CONFIGURATION
 // ================================================================
-DMXFixture FIXTURES[] = {DMXFixture(1, BRIGHTNESS_CAP), DMXFixture(7, BRIGHTNESS_CAP), DMXFixture(13, BRIGHTNESS_CAP), DMXFixture(19, BRIGHTNESS_CAP)};                                      // configured fixtures and their start channels. The maximum amount of supported fixtures is 16.
-const FixtureProfile RGB_COLOR_SET[] = {FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0x0000FF, 0x0039000), FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0x00FF00, 0xFF00000)}; // profiles that fixtures can assume. Each profile consists of a hex code for color and a hex code for frequencies the fixture should respond to.
-const FixtureProfile CMY_COLOR_SET[] = {FixtureProfile(0x800080, 0x00000FF), FixtureProfile(0xA06000, 0xFF00000), FixtureProfile(0x800080, 0x00000FF), FixtureProfile(0x008080, 0x0039000)};
-const FixtureProfile COLD_COLOR_SET[] = {FixtureProfile(0x4B00B4, 0x00000FF), FixtureProfile(0x0000FF, 0xFF00000), FixtureProfile(0x4B00B4, 0x00000FF), FixtureProfile(0x464673, 0x0039000)};
-const FixtureProfile UWU_COLOR_SET[] = {FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0x71008E, 0xFF00000), FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0xAA0055, 0x0039000)};
-const uint8_t FIXTURE_AMOUNT = sizeof(FIXTURES) / sizeof(DMXFixture);
+const uint8_t FIXTURE_AMOUNT = 4;                                                             // amount of configured fixtures.
+const uint8_t FIXTURE_START_CHANNEL = 1;                                                      // start channel of the first fixture. Fixtures occupy consecutive channels.
+using ConfiguredFixtures = FixtureBank<RGBWStrobePersonality, FIXTURE_AMOUNT>;                // personality of the configured fixtures (see FixturePersonality.h).
+ConfiguredFixtures FIXTURES(FIXTURE_START_CHANNEL, BRIGHTNESS_CAP);                           // configured fixtures.
+const uint16_t DMX_CHANNEL_AMOUNT = ConfiguredFixtures::getEndChannel(FIXTURE_START_CHANNEL); // highest DMX channel occupied by the configured fixtures, sizes the DMX buffers.
+const uint32_t LCD_I2C_CLOCK = HD44780_I2C_CLOCK_STANDARD;                                    // I2C clock of the display. HD44780_I2C_CLOCK_FAST redraws pages 4x faster, but only on short wires.
+const uint8_t DMX_READ_ENABLE_PIN = 2;                                                        // read enable pin of the DMX shield. Switched through its port registers while it equals DMX_FAST_READ_ENABLE_PIN (see Conceptinetics.h).
+const FixtureProfile RGB_COLOR_SET[] PROGMEM = {FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0x0000FF, 0x0039000), FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0x00FF00, 0xFF00000)}; // profiles that fixtures can assume. Each profile consists of a hex code for color and a hex code for frequencies the fixture should respond to.
+const FixtureProfile CMY_COLOR_SET[] PROGMEM = {FixtureProfile(0x800080, 0x00000FF), FixtureProfile(0xA06000, 0xFF00000), FixtureProfile(0x800080, 0x00000FF), FixtureProfile(0x008080, 0x0039000)};
+const FixtureProfile COLD_COLOR_SET[] PROGMEM = {FixtureProfile(0x4B00B4, 0x00000FF), FixtureProfile(0x0000FF, 0xFF00000), FixtureProfile(0x4B00B4, 0x00000FF), FixtureProfile(0x464673, 0x0039000)};
+const FixtureProfile UWU_COLOR_SET[] PROGMEM = {FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0x71008E, 0xFF00000), FixtureProfile(0xFF0000, 0x00000FF), FixtureProfile(0xAA0055, 0x0039000)};
 const uint8_t PROFILE_AMOUNT = sizeof(RGB_COLOR_SET) / sizeof(FixtureProfile);
-const FixtureProfile *const PROFILE_GROUPS[] = {RGB_COLOR_SET, CMY_COLOR_SET, COLD_COLOR_SET, UWU_COLOR_SET};
+const FixtureProfile *const PROFILE_GROUPS[] PROGMEM = {RGB_COLOR_SET, CMY_COLOR_SET, COLD_COLOR_SET, UWU_COLOR_SET}; // profile sets selectable via the color setting. All profile sets must contain PROFILE_AMOUNT profiles.
+static_assert(sizeof(CMY_COLOR_SET) == sizeof(RGB_COLOR_SET) && sizeof(COLD_COLOR_SET) == sizeof(RGB_COLOR_SET) && sizeof(UWU_COLOR_SET) == sizeof(RGB_COLOR_SET), "All profile sets must contain PROFILE_AMOUNT profiles.");
+const uint8_t COLOR_SET_AMOUNT = sizeof(PROFILE_GROUPS) / sizeof(PROFILE_GROUPS[0]); // amount of values of the color setting, one per profile group.
+const uint8_t WHITE_LIGHT_MODE_AMOUNT = 4; // amount of values of the lights setting, see LIGHTS_ALIASES.
+const uint8_t GAIN_MODE_AMOUNT = 3;        // amount of values of the gain setting, see GAIN_ALIASES.
+const uint8_t STROBE_FREQUENCY_MAX = 100;  // highest value of the strobe setting, in percent of the fixtures' fastest strobe.
 uint8_t whiteLightSetting = 0;
 uint8_t gainModeSetting = 0;
 uint8_t strobeFrequencySetting = 100;
 bool strobeEnabled = false;
 uint8_t colorSetSetting = 0;
 uint8_t msPerFrameMonitor = 0;
+uint8_t changedChannelsMonitor = 0;
+uint8_t lateFramesMonitor = 0;
+uint8_t profiledStageSetting = 0;
+uint8_t stageMinMonitor = 0; // duration of the profiled stage, in 0.1ms
+uint8_t stageAverageMonitor = 0;
+uint8_t stageMaxMonitor = 0;
+uint8_t stageHistogramMonitor[PROFILER_BUCKET_AMOUNT]; // bars of the histogram page: durations of the profiled stage below 128us, 512us, 2ms, 8ms, 33ms, 131ms, 524ms and above
+uint8_t medianJitterMonitor = 0; // period jitter of the lights, in 0.1ms
+uint8_t tailJitterMonitor = 0;
+uint8_t overloadMonitor = 0;
+uint8_t noiseFloorMonitor = 0;    // lowest cross-band audio level of the last minute, in ADC steps / 4. Compare with the noise level, which is restored from EEPROM.
+uint8_t firstDmxFrameMonitor = 0; // time from startup until the first DMX frame was started, in ms
+uint8_t audioMonitor[AUDIO_BANDS + 2]; // bars of the audio page: peak of each band, gain, peak of the cross-band clipping. Peaks are reset on every monitor refresh
 void toggleStrobe(bool alternateAction)
 {
     strobeEnabled ^= 1;
 }
-const SettingsPage SETTINGS_PAGES[] = {SettingsPageFactory("Lights", &whiteLightSetting).setLinkedVariableLimits(0, 4).setDisplayAlias("  OFF  BARTABLE  ALL").finalize(), SettingsPageFactory("Strobe", &strobeFrequencySetting).setLinkedVariableLimits(0, 101).setLinkedVariableUnits('%').finalize(), SettingsPageFactory("Gain", &gainModeSetting).setLinkedVariableLimits(0, 3).setDisplayAlias(" AUTO  LOW HIGH").enableChangePreviews().finalize(), SettingsPageFactory("Colors", &colorSetSetting).setLinkedVariableLimits(0, 4).setDisplayAlias("  RGB  CMY COLD  uwu").enableChangePreviews().finalize(), SettingsPageFactory("Frame ms", &msPerFrameMonitor).makeMonitor().finalize()};
+const char PAGE_NAME_LIGHTS[] PROGMEM = "Lights"; // texts of the settings pages, kept in flash memory
+const char PAGE_NAME_STROBE[] PROGMEM = "Strobe";
+const char PAGE_NAME_GAIN[] PROGMEM = "Gain";
+const char PAGE_NAME_AUDIO[] PROGMEM = "Audio";
+const char PAGE_NAME_COLORS[] PROGMEM = "Colors";
+const char PAGE_NAME_FRAME_MS[] PROGMEM = "Frame ms";
+const char PAGE_NAME_DMX_CHANGES[] PROGMEM = "DMX chg";
+const char PAGE_NAME_LATE_FRAMES[] PROGMEM = "Late frm";
+const char PAGE_NAME_PROFILE[] PROGMEM = "Profile";
+const char PAGE_NAME_STAGE_MIN[] PROGMEM = "Stg min";
+const char PAGE_NAME_STAGE_AVERAGE[] PROGMEM = "Stg avg";
+const char PAGE_NAME_STAGE_MAX[] PROGMEM = "Stg max";
+const char PAGE_NAME_STAGE_HISTOGRAM[] PROGMEM = "Histo";
+const char PAGE_NAME_MEDIAN_JITTER[] PROGMEM = "Jit p50";
+const char PAGE_NAME_TAIL_JITTER[] PROGMEM = "Jit p99";
+const char PAGE_NAME_OVERLOAD[] PROGMEM = "Overload";
+const char PAGE_NAME_FIRST_DMX_FRAME[] PROGMEM = "Boot ms";
+const char PAGE_NAME_NOISE_FLOOR[] PROGMEM = "Floor 1m";
+const char LIGHTS_ALIASES[] PROGMEM = "  OFF  BARTABLE  ALL";
+const char GAIN_ALIASES[] PROGMEM = " AUTO  LOW HIGH";
+const char COLORS_ALIASES[] PROGMEM = "  RGB  CMY COLD  uwu";
+const char PROFILE_ALIASES[] PROGMEM = "AUDIO  AGC  ROT RNDR BTNS   UI";
+const char OVERLOAD_ALIASES[] PROGMEM = " NONEDEFER  LOW";
+SettingsPage SETTINGS_PAGES[] = {SettingsPageFactory(PAGE_NAME_LIGHTS, &whiteLightSetting).setLinkedVariableLimits(0, WHITE_LIGHT_MODE_AMOUNT).setDisplayAlias(LIGHTS_ALIASES).finalize(), SettingsPageFactory(PAGE_NAME_STROBE, &strobeFrequencySetting).setLinkedVariableLimits(0, STROBE_FREQUENCY_MAX + 1).setLinkedVariableUnits('%').finalize(), SettingsPageFactory(PAGE_NAME_GAIN, &gainModeSetting).setLinkedVariableLimits(0, GAIN_MODE_AMOUNT).setDisplayAlias(GAIN_ALIASES).enableChangePreviews().finalize(), SettingsPageFactory(PAGE_NAME_AUDIO, audioMonitor).makeBarGraph(sizeof(audioMonitor)).finalize(), SettingsPageFactory(PAGE_NAME_COLORS, &colorSetSetting).setLinkedVariableLimits(0, COLOR_SET_AMOUNT).setDisplayAlias(COLORS_ALIASES).enableChangePreviews().finalize(), SettingsPageFactory(PAGE_NAME_FRAME_MS, &msPerFrameMonitor).makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_DMX_CHANGES, &changedChannelsMonitor).makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_LATE_FRAMES, &lateFramesMonitor).makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_PROFILE, &profiledStageSetting).setLinkedVariableLimits(0, 6).setDisplayAlias(PROFILE_ALIASES).finalize(), SettingsPageFactory(PAGE_NAME_STAGE_MIN, &stageMinMonitor).showAsMilliseconds().makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_STAGE_AVERAGE, &stageAverageMonitor).showAsMilliseconds().makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_STAGE_MAX, &stageMaxMonitor).showAsMilliseconds().makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_STAGE_HISTOGRAM, stageHistogramMonitor).makeBarGraph(sizeof(stageHistogramMonitor)).finalize(), SettingsPageFactory(PAGE_NAME_MEDIAN_JITTER, &medianJitterMonitor).showAsMilliseconds().makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_TAIL_JITTER, &tailJitterMonitor).showAsMilliseconds().makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_OVERLOAD, &overloadMonitor).setLinkedVariableLimits(0, 3).setDisplayAlias(OVERLOAD_ALIASES).makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_FIRST_DMX_FRAME, &firstDmxFrameMonitor).makeMonitor().finalize(), SettingsPageFactory(PAGE_NAME_NOISE_FLOOR, &noiseFloorMonitor).makeMonitor().finalize()};
 
 // ================================================================
 //                           SUBSYSTEMS
 // ================================================================
-DMX_Master dmxMaster(FIXTURES[0].channelAmount *FIXTURE_AMOUNT, 2);
-MSGEQ7 MSGEQ7(7, 4, 0);
+DMX_Master dmxMaster(DMX_CHANNEL_AMOUNT, DMX_READ_ENABLE_PIN);
+FrameInterpolator<DMX_CHANNEL_AMOUNT> lightInterpolator(dmxMaster, FRAME_PERIOD_MS / DMX_FRAME_PERIOD_MS);
+ProfileRotation<FIXTURE_AMOUNT> profileRotation(PROFILE_GROUPS, PROFILE_AMOUNT, PROFILE_CYCLE_PERIOD_MS);
+MSGEQ7<7, 4, 0> audioAnalyzer; // strobe, reset and data pin
 uint16_t bandAmplitudes[AUDIO_BANDS];
+uint16_t bandSampleSums[AUDIO_BANDS]; // sums of the audio samples taken since the last frame
+uint8_t bandSampleCount = 0;
 float amplificationFactor = 12.0; // amplification for signals considered non-noise (ones that should result in a non-zero light response), managed automatically
 uint16_t noiseLevel = 0;          // lower bound for noise, determined automatically at startup
-SettingsDisplay<5> userInterface(SETTINGS_PAGES);
-LatchedButton<8> plusButton(3, 1000 / FRAME_PERIOD_MS);
-LatchedButton<8> selectButton(5, 1000 / FRAME_PERIOD_MS);
-LatchedButton<8> minusButton(6, 1000 / FRAME_PERIOD_MS);
-LatchedButton<8> functionButton(9, 1000 / FRAME_PERIOD_MS);
+DecimatingHistory<uint8_t, 16, 3, 8> audioLevelHistory; // cross-band audio level of every frame, covering 1s, 8s and 67s
+struct StoredSettings             // settings and calibration kept in EEPROM, so they survive a power cycle
+{
+    uint8_t whiteLight;
+    uint8_t gainMode;
+    uint8_t strobeFrequency;
+    uint8_t colorSet;
+    float amplificationFactor;
+    uint16_t noiseLevel;
+};
+SettingsStore<StoredSettings> settingsStore(0, E2END + 1, SETTINGS_SETTLE_MS); // uses the whole EEPROM
+SettingsDisplay<18> userInterface(SETTINGS_PAGES);
+using UserButtons = ButtonGroup<8, 9, 6, 5, 3>; // latch reset on pin 8, function, minus, select and plus buttons on pins 9, 6, 5 and 3, in the order of the user interface's button codes
+ButtonEvents<UserButtons> buttons(BUTTON_HOLD_MS, BUTTON_REPEAT_MS, BUTTON_DOUBLE_PRESS_MS);
+CooperativeScheduler<10> scheduler;
+uint8_t audioTaskId = NO_TASK;
+uint8_t renderTaskId = NO_TASK;
+uint8_t monitorTaskId = NO_TASK;
+uint8_t screenSaverTaskId = NO_TASK;
+uint8_t splashTaskId = NO_TASK;
+OverloadGovernor overloadGovernor(FRAME_PERIOD_MS * 1000ul, OVERLOAD_REDUCE_AUDIO, OVERLOAD_RECOVERY_FRAMES);
+const uint8_t STAGE_AUDIO = 0; // stages of a frame as measured by the profiler, in the order of the profile setting's aliases
+const uint8_t STAGE_AGC = 1;
+const uint8_t STAGE_ROTATION = 2;
+const uint8_t STAGE_RENDER = 3;
+const uint8_t STAGE_BUTTONS = 4;
+const uint8_t STAGE_UI = 5;
+const char STAGE_NAME_AUDIO[] PROGMEM = "audio";
+const char STAGE_NAME_AGC[] PROGMEM = "agc";
+const char STAGE_NAME_ROTATION[] PROGMEM = "rotation";
+const char STAGE_NAME_RENDER[] PROGMEM = "render";
+const char STAGE_NAME_BUTTONS[] PROGMEM = "buttons";
+const char STAGE_NAME_UI[] PROGMEM = "ui";
+const char *const STAGE_NAMES[] PROGMEM = {STAGE_NAME_AUDIO, STAGE_NAME_AGC, STAGE_NAME_ROTATION, STAGE_NAME_RENDER, STAGE_NAME_BUTTONS, STAGE_NAME_UI};
+FrameProfiler<6> profiler(STAGE_NAMES);
+#ifdef PROFILER_DUMP_PIN
+SoftwareSerial profilerSerial(PROFILER_DUMP_PIN + 1, PROFILER_DUMP_PIN); // receive pin is required, but never read
+#endif
 
 // ================================================================
 //                       STARTUP SEQUENCE
 // ================================================================
 void setup()
 {
-    // Start LCD
-    userInterface.setQuickSettingFunction(toggleStrobe);
-    userInterface.initializeDisplay(0x27);
-    userInterface.print(F("   Phosphoros   "), F(" ver 2023-07-02 "));
-    delay(1000);
+    // Restore Settings
+    bool calibrated = restoreSettings();
 
-    // Start FFT
-    userInterface.print(F("    Starting    "), F("Audio Analyzer.."));
-    MSGEQ7.init();
-
-    // Start DMX
-    userInterface.print(F("    Starting    "), F("DMX Controller.."));
+    // Start DMX first, so the fixtures receive frames right away, e.g. when the controller restarts after a brownout mid-show
+    for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
+    {
+        lightInterpolator.snapChannel(FIXTURES.getStartChannel(fixtureId) + RGBWStrobePersonality::strobeChannel); // strobe rates must not be blended
+    }
+    dmxMaster.onFrameStart(interpolateLights);
     dmxMaster.setAutoBreakMode();
     dmxMaster.enable();
 
     // Initialize Light Fixtures
-    for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
-    {
-        FIXTURES[fixtureId].reset(); // reset to default values
-    }
+    FIXTURES.reset(); // reset to default values
+
+    // Start FFT and Buttons
+    audioAnalyzer.init();
+    buttons.init();
+
+    // Start LCD
+    userInterface.setQuickSettingFunction(toggleStrobe);
+    userInterface.setSaveFunction(saveSettings);
+    userInterface.initializeDisplay(0x27, LCD_I2C_CLOCK);
 
     // Analyze Noise Levels (THERE MUST NOT BE AUDIO ON THE JACK FOR THIS TO WORK)
-    userInterface.print(F("    Probing     "), F("     Noise...    "));
-    uint16_t noiseData[] = {0, 0, 0, 0, 0, 0, 0};
-    MSGEQ7.queryBands(noiseData, 32, 1);
-    noiseLevel = getAverage(noiseData, AUDIO_BANDS, 12); // average over all frequencies and add some extra buffer
+    // Skipped if the noise level was restored, unless the function button is held during startup.
+    if (!calibrated || (UserButtons::read() & 0b0001))
+    {
+        userInterface.print(F("    Probing     "), F("     Noise...    "));
+        uint16_t noiseData[] = {0, 0, 0, 0, 0, 0, 0};
+        audioAnalyzer.queryBands(noiseData, 32, 1);
+        noiseLevel = getAverage(noiseData, AUDIO_BANDS, 12); // average over all frequencies and add some extra buffer
+        saveSettings();                                      // keep the noise level for the next startup
+    }
 
-    userInterface.print(F("     Setup      "), F("   Complete!    "));
-    delay(500); // wait a bit for everything to stabalize
-    userInterface.showPages();
+    // Schedule Tasks, audio and lights take precedence over the user interface
+    audioTaskId = scheduler.addTask(sampleAudio, AUDIO_PERIOD_MS, 4);
+    renderTaskId = scheduler.addTask(renderLights, FRAME_PERIOD_MS, 3);
+    scheduler.addTask(pollButtons, BUTTON_PERIOD_MS, 2);
+    monitorTaskId = scheduler.addTask(refreshMonitor, MONITOR_PERIOD_MS, 1);
+    scheduler.addTask(drawScreen, SCREEN_PERIOD_MS, 1);
+    screenSaverTaskId = scheduler.addTask(checkScreenSaver, SCREEN_SAVER_PERIOD_MS, 0);
+    scheduler.addTask(storeSettings, SETTINGS_STORE_PERIOD_MS, 0);
+    scheduler.addTask(saveSettings, GAIN_SAVE_PERIOD_MS, 0);
+    splashTaskId = scheduler.addTask(endSplash, SPLASH_MS, 0);
+#ifdef PROFILER_DUMP_PIN
+    profilerSerial.begin(9600);
+    scheduler.addTask(dumpProfiler, PROFILER_DUMP_PERIOD_MS, 0);
+#endif
+
+    // Show the splash screen while the lights are already running, see endSplash()
+    userInterface.print(F("   Phosphoros   "), F(" ver 2023-07-02 "));
+    scheduler.start();
 }
 
 // ================================================================
 //                           MAIN LOOP
 // ================================================================
 void loop()
+{
+    scheduler.run();
+}
+
+// ================================================================
+//                             TASKS
+// ================================================================
+
+/**
+ * @brief Takes a reading of all bands from the MSGEQ7 chip and adds it to the samples of the current frame.
+ */
+void sampleAudio()
+{
+    if (bandSampleCount == 64) // sums would overflow, the frame is late anyways
+        return;
+
+    profiler.begin(STAGE_AUDIO);
+    uint16_t sampleAmplitudes[AUDIO_BANDS];
+    audioAnalyzer.queryBands(sampleAmplitudes);
+    for (uint8_t band = 0; band < AUDIO_BANDS; band++)
+    {
+        bandSampleSums[band] += sampleAmplitudes[band];
+    }
+    bandSampleCount++;
+    profiler.end();
+}
+
+/**
+ * @brief Renders a frame: Averages the audio samples taken since the last frame, transforms them into light levels and sends these to the fixtures.
+ */
+void renderLights()
 {
     // Store frame start time
-    uint32_t frameStartTime = millis();
+    uint32_t frameStartTime = micros();
 
-    // Get FFT data from MSGEQ7 chip
-    MSGEQ7.queryBands(bandAmplitudes);
+    // Average audio samples of this frame
+    if (bandSampleCount == 0)
+    {
+        sampleAudio();
+    }
+    for (uint8_t band = 0; band < AUDIO_BANDS; band++)
+    {
+        bandAmplitudes[band] = bandSampleSums[band] / bandSampleCount;
+        bandSampleSums[band] = 0;
+    }
+    bandSampleCount = 0;
 
     // Transform audio signal levels to light signal levels and apply amplification
+    profiler.begin(STAGE_AGC);
+    audioLevelHistory.update(getAverage(bandAmplitudes, AUDIO_BANDS, 0) >> 2);
     uint16_t signalMean = calculateSignalMean(bandAmplitudes, noiseLevel);
     uint16_t crossBandClipping = mapAudioAmplitudeToLightLevel(bandAmplitudes, signalMean + noiseLevel, amplificationFactor);
     updateAmplificationFactor(amplificationFactor, crossBandClipping);
+    updateAudioMonitor(bandAmplitudes, crossBandClipping);
+    profiler.end();
 
     // Select and Cycle Fixture Profiles
-    FixtureProfile permutatedProfiles[FIXTURE_AMOUNT];
-    permutateProfiles(generatePermutationCode(), permutatedProfiles);
+    profiler.begin(STAGE_ROTATION);
+    profileRotation.update(colorSetSetting, overloadMonitor < OVERLOAD_DEFER); // a new color set is applied even when rotation is deferred
+    profiler.end();
 
     // Manage Fixtures
+    profiler.begin(STAGE_RENDER);
     for (uint8_t fixtureId = 0; fixtureId < FIXTURE_AMOUNT; fixtureId++)
     {
-        setFixtureColor(FIXTURES[fixtureId], bandAmplitudes, permutatedProfiles[fixtureId].getHexColor());          // set color data
-        setFixtureBrightness(FIXTURES[fixtureId], bandAmplitudes, permutatedProfiles[fixtureId].getHexFrequency()); // set brightness data
-        setFixtureWhite(FIXTURES[fixtureId], fixtureId, strobeEnabled, strobeFrequencySetting, whiteLightSetting);
-
-        // send data to fixtures
-        FIXTURES[fixtureId].display(dmxMaster);
+        setFixtureColor(fixtureId, bandAmplitudes, profileRotation.getProfile(fixtureId).getHexColor()); // set color data
+        setFixtureBrightness(fixtureId, bandAmplitudes, profileRotation.getBandResponse(fixtureId));     // set brightness data
+        setFixtureWhite(fixtureId, strobeEnabled, strobeFrequencySetting, whiteLightSetting);
     }
 
-    // Send Button inputs to UI and update UI accordingly
-    if (plusButton.isPressed())
+    // send data to fixtures, the transition to the new values is spread over the next DMX frames
+    uint16_t changedChannels = FIXTURES.display(lightInterpolator.getPendingFrame(), DMX_CHANNEL_AMOUNT + 1);
+    if (changedChannels > 0)
     {
-        userInterface.input(3, false);
+        lightInterpolator.commit();
     }
+    changedChannelsMonitor = min(changedChannels, 255);
+    profiler.end();
 
-    if (minusButton.isPressed())
+    msPerFrameMonitor = min((micros() - frameStartTime) / 1000, 255);
+    lateFramesMonitor = min(scheduler.getOverruns(renderTaskId), 255);
+
+    // Shed or restore non-critical work depending on how long it took from the frame being due until now
+    uint8_t overloadLevel = overloadGovernor.update(scheduler.getLateness(renderTaskId) + (micros() - frameStartTime));
+    if (overloadLevel != overloadMonitor)
     {
-        userInterface.input(1, false);
+        applyOverloadLevel(overloadLevel);
     }
+}
 
-    if (selectButton.isPressed())
+/**
+ * @brief Defers or restores non-critical work according to the supplied overload level.
+ * Monitor updates, the screen saver and profile rotation are deferred from OVERLOAD_DEFER on, audio is sampled at half the rate from OVERLOAD_REDUCE_AUDIO on.
+ *
+ * @param overloadLevel The overload level as determined by the overload governor.
+ */
+void applyOverloadLevel(uint8_t overloadLevel)
+{
+    scheduler.setEnabled(monitorTaskId, overloadLevel < OVERLOAD_DEFER);
+    scheduler.setEnabled(screenSaverTaskId, overloadLevel < OVERLOAD_DEFER);
+    scheduler.setPeriod(audioTaskId, (overloadLevel < OVERLOAD_REDUCE_AUDIO) ? AUDIO_PERIOD_MS : 2 * AUDIO_PERIOD_MS);
+    overloadMonitor = overloadLevel;
+}
+
+/**
+ * @brief Hands the button events queued since the last call to the UI, which updates accordingly.
+ * Presses are queued by the pin change interrupts, holds and releases by probing the held buttons here.
+ */
+void pollButtons()
+{
+    profiler.begin(STAGE_BUTTONS);
+#if defined(PROFILER_DUMP_PIN) && defined(__AVR__)
+    buttons.onPinChange(); // no pin change interrupts, see below
+#endif
+    buttons.update();
+
+    ButtonEvent event;
+    while (buttons.read(event))
     {
-        userInterface.input(2, false);
+        if (event.type != BUTTON_RELEASE) // holds repeat the button, double presses request the alternate action
+        {
+            userInterface.input(event.button, event.type == BUTTON_DOUBLE_PRESS);
+        }
     }
+    profiler.end();
+}
+
+#if defined(PROFILER_DUMP_PIN) && defined(__AVR__)
+// SoftwareSerial defines all pin change interrupt vectors, so presses are only picked up by pollButtons() while the profiler dump is enabled
+#else
+/**
+ * @brief Pin change interrupts of the button pins: pin 9 is in pin group 0, pins 3, 5 and 6 are in pin group 2.
+ */
+ISR(PCINT0_vect)
+{
+    buttons.onPinChange();
+}
+
+ISR(PCINT2_vect)
+{
+    buttons.onPinChange();
+}
+#endif
+
+/**
+ * @brief Refreshes the value shown on the display if the current page is a monitor.
+ */
+void refreshMonitor()
+{
+    profiler.begin(STAGE_UI);
+    updateStageMonitors(profiledStageSetting);
+    medianJitterMonitor = min(scheduler.getJitterPercentile(renderTaskId, 50) / 100, 255);
+    tailJitterMonitor = min(scheduler.getJitterPercentile(renderTaskId, 99) / 100, 255);
+    noiseFloorMonitor = audioLevelHistory.getLevelMin(audioLevelHistory.levels() - 1);
+    audioMonitor[AUDIO_BANDS] = 255 * log(amplificationFactor / AMP_FACTOR_MIN) / log(AMP_FACTOR_MAX / AMP_FACTOR_MIN); // the gain holds no peak, so it is only sampled when shown
+    userInterface.updateMonitor();
+    memset(audioMonitor, 0, AUDIO_BANDS); // start collecting the peaks shown on the next refresh, the gain bar stays until it is sampled again
+    audioMonitor[AUDIO_BANDS + 1] = 0;
+    profiler.end();
+}
 
-    if (functionButton.isPressed())
+/**
+ * @brief Copies the durations of a profiled stage to the stage monitors. The histogram bars are scaled to the fullest bucket,
+ * every non-empty bucket shows at least one pixel row, so a few slow outliers remain visible next to thousands of regular durations.
+ *
+ * @param stage The stage whose durations should be shown.
+ */
+void updateStageMonitors(uint8_t stage)
+{
+    stageMinMonitor = min(profiler.getMin(stage) / 100, 255);
+    stageAverageMonitor = min(profiler.getAverage(stage) / 100, 255);
+    stageMaxMonitor = min(profiler.getMax(stage) / 100, 255);
+
+    uint8_t fullestBucket = 1;
+    for (uint8_t bucket = 0; bucket < PROFILER_BUCKET_AMOUNT; bucket++)
     {
-        userInterface.input(0, false);
+        fullestBucket = max(fullestBucket, profiler.getBucket(stage, bucket));
     }
-    LatchedButton<8>::resetLatch();
+    for (uint8_t bucket = 0; bucket < PROFILER_BUCKET_AMOUNT; bucket++)
+    {
+        uint8_t durations = profiler.getBucket(stage, bucket);
+        stageHistogramMonitor[bucket] = durations ? max((uint16_t)durations * 255 / fullestBucket, 16) : 0; // 16 is the lowest value drawn as a pixel row
+    }
+}
+
+/**
+ * @brief Sends a bounded amount of pending user interface changes to the LCD, so the screen catches up without stalling a frame.
+ */
+void drawScreen()
+{
+    profiler.begin(STAGE_UI);
+    userInterface.update(SCREEN_BYTES_PER_UPDATE);
+    profiler.end();
+}
+
+/**
+ * @brief Turns on the screen saver if no input was received for a while.
+ */
+void checkScreenSaver()
+{
+    profiler.begin(STAGE_UI);
     userInterface.checkScreenSaver();
-    userInterface.updateMonitor();
+    profiler.end();
+}
+
+/**
+ * @brief Hands the current settings and calibration to the settings store, which writes them to EEPROM once they stopped changing.
+ * Called whenever the user saves a page, and regularly to keep the learned amplification factor.
+ */
+void saveSettings()
+{
+    StoredSettings settings;
+    memset(&settings, 0, sizeof(settings)); // padding must not tell equal settings apart
+    settings.whiteLight = whiteLightSetting;
+    settings.gainMode = gainModeSetting;
+    settings.strobeFrequency = strobeFrequencySetting;
+    settings.colorSet = colorSetSetting;
+    settings.amplificationFactor = amplificationFactor;
+    settings.noiseLevel = noiseLevel;
+    settingsStore.save(settings);
+}
+
+/**
+ * @brief Writes the next byte of saved settings to EEPROM, if the EEPROM is ready. Never waits for the EEPROM, so it does not stall a frame.
+ */
+void storeSettings()
+{
+    settingsStore.update();
+}
 
-    // Wait until frame time is over
-    msPerFrameMonitor = (uint8_t)(millis() - frameStartTime);
-    int16_t remainingFrameTimeMs = FRAME_PERIOD_MS - msPerFrameMonitor;
-    delay(max(remainingFrameTimeMs, 0));
+/**
+ * @brief Replaces the splash screen by the settings pages once SPLASH_MS passed since startup, then disables itself.
+ * The first release right at the start of the scheduler is too early, so the pages are shown on the second one.
+ */
+void endSplash()
+{
+    if (millis() < SPLASH_MS)
+        return;
+
+    userInterface.showPages();
+    scheduler.setEnabled(splashTaskId, false);
 }
 
+#ifdef PROFILER_DUMP_PIN
+/**
+ * @brief Prints the durations recorded by the profiler to the profiler's serial port.
+ */
+void dumpProfiler()
+{
+    profiler.dump(profilerSerial);
+}
+#endif
+
 // ================================================================
 //                       HELPER FUNCTIONS
 // ================================================================
 
+/**
+ * @brief Restores the settings and calibration last saved to EEPROM. Keeps the defaults if nothing was saved yet.
+ * Values are limited to the ranges of their pages, in case these changed since they were saved.
+ *
+ * @return true If the settings were restored, including the noise level.
+ * @return false If nothing was saved yet, so the noise level has to be probed.
+ */
+bool restoreSettings()
+{
+    StoredSettings settings;
+    if (!settingsStore.restore(settings))
+        return false;
+
+    whiteLightSetting = min(settings.whiteLight, WHITE_LIGHT_MODE_AMOUNT - 1); // records of a different build may hold values out of the pages' limits
+    gainModeSetting = min(settings.gainMode, GAIN_MODE_AMOUNT - 1);
+    strobeFrequencySetting = min(settings.strobeFrequency, STROBE_FREQUENCY_MAX);
+    colorSetSetting = min(settings.colorSet, COLOR_SET_AMOUNT - 1);
+    amplificationFactor = constrain(settings.amplificationFactor, AMP_FACTOR_MIN, AMP_FACTOR_MAX);
+    noiseLevel = min(settings.noiseLevel, AUDIO_BAND_MAX);
+    return true;
+}
+
 /**
  * @brief Calculates the temporal mean value of an audio signal, with the noise level removed.
  *
@@ -216,7 +571,16 @@ uint16_t mapAudioAmplitudeToLightLevel(uint16_t *bandAmplitudes, uint16_t bandAv
 void updateAmplificationFactor(float &amplificationFactor, uint16_t crossBandClipping)
 {
     static NumericHistory<uint16_t, 32> clippingHistory = NumericHistory<uint16_t, 32>();
+    static bool clippingHistorySeeded = false;
 
+    if (!clippingHistorySeeded) // start from the clipping that results in the current (e.g. restored) amplification factor
+    {
+        for (uint8_t entry = 0; entry < clippingHistory.length(); entry++)
+        {
+            clippingHistory.update(min(TARGET_CLIPPING / amplificationFactor, AUDIO_BAND_MAX));
+        }
+        clippingHistorySeeded = true;
+    }
     clippingHistory.update(crossBandClipping);
     if (gainModeSetting == 0)
     {
@@ -233,6 +597,22 @@ void updateAmplificationFactor(float &amplificationFactor, uint16_t crossBandCli
     }
 }
 
+/**
+ * @brief Feeds the bars of the audio page. Bands and clipping hold their peak until the next monitor refresh,
+ * so short beats between two refreshes still show. The gain bar is sampled by refreshMonitor(), as its logarithm is too costly to take every frame.
+ *
+ * @param bandAmplitudes [0..255] Light levels of the bands, as returned by `mapAudioAmplitudeToLightLevel()`.
+ * @param crossBandClipping [0..1023] The latest cross-band clipping average.
+ */
+void updateAudioMonitor(uint16_t *bandAmplitudes, uint16_t crossBandClipping)
+{
+    for (uint8_t band = 0; band < AUDIO_BANDS; band++)
+    {
+        audioMonitor[band] = max(audioMonitor[band], bandAmplitudes[band]);
+    }
+    audioMonitor[AUDIO_BANDS + 1] = max(audioMonitor[AUDIO_BANDS + 1], crossBandClipping >> 2);
+}
+
 /**
  * @brief Gets the average value of an array.
  *
@@ -241,7 +621,7 @@ void updateAmplificationFactor(float &amplificationFactor, uint16_t crossBandCli
  * @param buffer [0..1023] Buffer value to be added onto the average after calculation.
  * @return Arithmetic average of the signal levels on all 7 bands plus the buffer value. Capped at 1023.
  */
-uint16_t getAverage(int *array, uint16_t elements, uint16_t buffer)
+uint16_t getAverage(uint16_t *array, uint16_t elements, uint16_t buffer)
 {
     uint16_t sum = 0;
     for (int i = 0; i < elements; i++)
@@ -254,119 +634,74 @@ uint16_t getAverage(int *array, uint16_t elements, uint16_t buffer)
 }
 
 /**
- * @brief Stores a permutated version of the supplied profile array `constProfiles` into `permutedProfiles` according to a supplied permutation instruction.
- *
- * @param permutation The permutation to be used when assembling `permutatedProfiles` from `constProfiles`. The permutation is encoded as a 64-bit number,
- * consisting of 16 consequtive source addresses. The target address is deducted from the position of the source address within the 64-bit instruction.
- * E.g. `0x01234567` would load the profile in slot 7 into the fixture in slot 0, the profile in slot 6 into the fixture in slot 1 and so on.
- * @param permutatedProfiles An array of FixtureProfiles that will have the permutation stored into it.
+ * @brief Advances the light transition by one DMX frame. Registered as frame start callback of the DMX controller, therefore called from the DMX TX ISR.
  */
-void permutateProfiles(uint64_t permutation, FixtureProfile *permutatedProfiles)
+void interpolateLights()
 {
-    // store shuffled profiles into arrays for the fixtures to read from.
-    // Note that these arrays only require a length of fixtureAmount, as any additional profiles will not be displayed on a fixture anyways.
-    for (uint8_t profileSlot = 0; profileSlot < FIXTURE_AMOUNT; profileSlot++)
+    static bool dmxStarted = false;
+    if (!dmxStarted) // boot time as seen by the fixtures
     {
-        // extract lowest instruction and shift remaining instructions
-        uint8_t profileSource = (permutation & 0xF);
-        permutation = (permutation >> 4);
-
-        // store to shuffled profile
-        permutatedProfiles[profileSlot] = PROFILE_GROUPS[colorSetSetting][profileSource];
+        firstDmxFrameMonitor = min(millis(), 255);
+        dmxStarted = true;
     }
-}
-
-/**
- * @brief Generates a new permutation code of the fixture to profile mapping, based on the last permutation.
- * Once the cycle length has been exceeded, the last permutation is cycled by one step,
- * otherwise the method returns the provided permutation without modifications.
- * This cycling is done to equally utilize LEDs over all fixture, preventing "burn in".
- *
- * @return uint64_t The (modified) permutation.
- */
-uint64_t generatePermutationCode()
-{
-    static uint32_t permutationTimestamp = 0;
-    static uint64_t permutationCode = 0xFEDCBA9876543210ul & ((0x1ul << (4 * PROFILE_AMOUNT)) - 0x1);
-
-    // if last permutation shift wasn't too long, return last permutation
-    uint32_t timeNow = millis();
-    if (timeNow - permutationTimestamp < PROFILE_CYCLE_PERIOD_MS)
-        return permutationCode;
-
-    // shift last permutation
-    permutationCode = (permutationCode >> 4) + ((permutationCode & ((0x1ul << 4) - 0x1)) << ((4 * PROFILE_AMOUNT) - 4));
-    permutationTimestamp = timeNow;
-    return permutationCode;
+    lightInterpolator.tick();
 }
 
 /**
     @brief Sets the color of a single fixture according to the supplied color response values.
 
-    @param &targetFixture Fixture to be adjusted.
-    @param *audioAmplitudes 7 element uint32_t array of amplitudes per frequency band.
+    @param fixtureId The id of the fixture in `FIXTURES` to be adjusted.
+    @param *audioAmplitudes 7 element uint16_t array of amplitudes per frequency band.
     @param colorResponse [0..0xFFFFFF] hex value that represents the color to be displayed by this fixture.
 */
-void setFixtureColor(DMXFixture &targetFixture, int *audioAmplitudes, uint32_t colorResponse)
+void setFixtureColor(uint8_t fixtureId, uint16_t *audioAmplitudes, uint32_t colorResponse)
 {
     // convert colors to rgb and send to fixture
-    targetFixture.setRGB(colorResponse >> 16, (colorResponse & 0x00FF00) >> 8, colorResponse & 0x0000FF);
+    FIXTURES.setRGB(fixtureId, colorResponse >> 16, (colorResponse & 0x00FF00) >> 8, colorResponse & 0x0000FF);
 }
 
 /**
-    @brief Sets the brightness of a single fixture according to the supplied audio response values.
+    @brief Sets the brightness of a single fixture according to the supplied audio response.
 
-    @param targetFixture Fixture to be adjusted.
-    @param audioAmplitudes 7 element uint32_t array of amplitudes per frequency band.
-    @param audioResponse [0..0xFFFFFFF] hex value that represents the frequencies this fixture should respond to.
+    @param fixtureId The id of the fixture in `FIXTURES` to be adjusted.
+    @param audioAmplitudes 7 element uint16_t array of amplitudes per frequency band, scaled to [0..255].
+    @param audioResponse The precomputed response of this fixture to the frequency bands (see BandResponse).
 */
-void setFixtureBrightness(DMXFixture &targetFixture, int *audioAmplitudes, uint32_t audioResponse)
+void setFixtureBrightness(uint8_t fixtureId, uint16_t *audioAmplitudes, BandResponse &audioResponse)
 {
-    uint8_t brightness = 0;
-    uint8_t observedBands = 0;
-    for (uint8_t band = 0; band < AUDIO_BANDS; band++)
-    {
-        uint8_t bandResponse = ((audioResponse & ((uint32_t)0xF << (band * 4))) >> (band * 4)); // get response coefficient (is between 0.0 .. 15.0)
-        if (bandResponse > 0)
-        {
-            brightness += ((float)bandResponse / 15.0) * audioAmplitudes[band]; // calculate brightness value via scaling the band amplitude by the response coefficient
-            observedBands++;
-        }
-    }
-    targetFixture.setRGBDimmer((uint8_t)(brightness / observedBands)); // set RGB dimmer to a normalized value
+    FIXTURES.setRGBDimmer(fixtureId, audioResponse.getBrightness(audioAmplitudes)); // set RGB dimmer to the normalized, response-weighted band amplitudes
 }
 
 /**
  * @brief Sets the white value of a single fixture according to the supplied whiteSetting and strobeEnabled.
  *
- * @param targetFixture The fixture object to be acted upon.
- * @param fixtureId The id of the currently targeted fixture. Used to allow for physical-location-based whiteSettings.
+ * @param fixtureId The id of the fixture in `FIXTURES` to be acted upon. Also used to allow for physical-location-based whiteSettings.
  * @param strobeEnabled Whether the strobe should be enabled.
- * @param strobeFrequency The frequency of the strobe, between 1 and 100 (inclusive)
+ * @param strobeFrequency The frequency of the strobe, between 1 and STROBE_FREQUENCY_MAX (inclusive)
  * @param whiteSetting Which whiteSetting to follow. This specifies which fixtures should have their white channels set to a non-zero value.
  */
-void setFixtureWhite(DMXFixture &targetFixture, uint8_t fixtureId, bool strobeEnabled, uint8_t strobeFrequency, uint8_t whiteSetting)
+void setFixtureWhite(uint8_t fixtureId, bool strobeEnabled, uint8_t strobeFrequency, uint8_t whiteSetting)
 {
     // reset white value to 0
-    targetFixture.setWhite(0);
+    FIXTURES.setWhite(fixtureId, 0);
 
     // reset strobe frequency to 0
-    targetFixture.setStrobe(0);
+    FIXTURES.setStrobe(fixtureId, 0);
 
     if (strobeEnabled) // if strobe is on, enable white on all fixtures
     {
-        targetFixture.setWhite(DMX_CHANNEL_MAX);
-        targetFixture.setStrobe(strobeFrequency * (DMX_CHANNEL_MAX / 100));
+        FIXTURES.setWhite(fixtureId, DMX_CHANNEL_MAX);
+        FIXTURES.setStrobe(fixtureId, strobeFrequency * (DMX_CHANNEL_MAX / STROBE_FREQUENCY_MAX));
     }
     else if (whiteSetting) // if strobe is off, white is only enabled on fixtures depending on white setting. If whiteSetting == 0, none of these special rules apply
     {
         if ((whiteSetting == 1 && fixtureId == 1) || (whiteSetting == 2 && fixtureId == 3))
         {
-            targetFixture.setWhite(32); // spotlight on bar or table, low light level
+            FIXTURES.setWhite(fixtureId, 32); // spotlight on bar or table, low light level
         }
         else if (whiteSetting == 3)
         {
-            targetFixture.setWhite(DMX_CHANNEL_MAX); // full bright mode for all lights on
+            FIXTURES.setWhite(fixtureId, DMX_CHANNEL_MAX); // full bright mode for all lights on
         }
     }
 }